@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "storage/clock_buffer_strategy.h"
+#include "storage/lru_buffer_strategy.h"
+#include "storage/lru_k_buffer_strategy.h"
+#include "storage/two_queue_buffer_strategy.h"
+
+// 缓存替换策略命中率测试
+// 访问序列由热点页面上的随机点查询和大表上的顺序扫描交替组成，
+// 顺序扫描逐条读取记录，对同一页面连续访问 records 次
+
+struct BenchOptions {
+  size_t buffer_size;
+  size_t hot_pages;
+  size_t scan_pages;
+  size_t records;
+  size_t lookups;
+  size_t rounds;
+};
+
+// 生成访问序列，热点页面编号为 [0, hot_pages)，扫描页面编号为 [hot_pages, hot_pages + scan_pages)
+std::vector<uint64_t> GenerateTrace(const BenchOptions &options) {
+  std::mt19937_64 rng(2024);
+  std::uniform_int_distribution<uint64_t> hot_dist(0, options.hot_pages - 1);
+  std::vector<uint64_t> trace;
+  for (size_t round = 0; round < options.rounds; round++) {
+    for (size_t i = 0; i < options.lookups; i++) {
+      trace.push_back(hot_dist(rng));
+    }
+    for (size_t page = 0; page < options.scan_pages; page++) {
+      for (size_t i = 0; i < options.records; i++) {
+        trace.push_back(options.hot_pages + page);
+      }
+    }
+  }
+  return trace;
+}
+
+struct ReplayResult {
+  size_t hits_ = 0;
+  size_t hot_accesses_ = 0;
+  size_t hot_hits_ = 0;
+};
+
+// 使用给定的替换策略重放访问序列，统计总命中次数及热点页面的命中次数
+ReplayResult Replay(huadb::BufferStrategy &strategy, const BenchOptions &options, const std::vector<uint64_t> &trace) {
+  std::unordered_map<uint64_t, size_t> page_table;
+  std::vector<uint64_t> frames;
+  ReplayResult result;
+  for (auto page : trace) {
+    bool hot = page < options.hot_pages;
+    result.hot_accesses_ += hot;
+    auto entry = page_table.find(page);
+    if (entry != page_table.end()) {
+      strategy.Access(entry->second);
+      result.hits_++;
+      result.hot_hits_ += hot;
+      continue;
+    }
+    size_t frame_no;
+    if (frames.size() < options.buffer_size) {
+      frame_no = frames.size();
+      frames.push_back(page);
+    } else {
+      frame_no = strategy.Evict();
+      if (frame_no == huadb::INVALID_FRAME_ID || frame_no >= options.buffer_size) {
+        std::cerr << "Invalid victim frame " << frame_no << std::endl;
+        std::exit(1);
+      }
+      page_table.erase(frames[frame_no]);
+      frames[frame_no] = page;
+    }
+    page_table[page] = frame_no;
+    strategy.Access(frame_no);
+  }
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("buffer-bench");
+  program.add_argument("-b", "--buffer-size").default_value(size_t{64}).scan<'u', size_t>();
+  program.add_argument("--hot-pages").default_value(size_t{48}).scan<'u', size_t>();
+  program.add_argument("--scan-pages").default_value(size_t{512}).scan<'u', size_t>();
+  program.add_argument("--records").default_value(size_t{32}).scan<'u', size_t>();
+  program.add_argument("--lookups").default_value(size_t{4096}).scan<'u', size_t>();
+  program.add_argument("--rounds").default_value(size_t{16}).scan<'u', size_t>();
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+
+  BenchOptions options;
+  options.buffer_size = program.get<size_t>("-b");
+  options.hot_pages = program.get<size_t>("--hot-pages");
+  options.scan_pages = program.get<size_t>("--scan-pages");
+  options.records = program.get<size_t>("--records");
+  options.lookups = program.get<size_t>("--lookups");
+  options.rounds = program.get<size_t>("--rounds");
+  if (options.buffer_size == 0 || options.hot_pages == 0 || options.records == 0 || options.lookups == 0) {
+    std::cerr << "buffer-size, hot-pages, records and lookups must be positive" << std::endl;
+    std::exit(1);
+  }
+
+  auto trace = GenerateTrace(options);
+  std::vector<std::pair<std::string, std::unique_ptr<huadb::BufferStrategy>>> strategies;
+  strategies.emplace_back("lru", std::make_unique<huadb::LRUBufferStrategy>());
+  strategies.emplace_back("clock", std::make_unique<huadb::ClockBufferStrategy>());
+  strategies.emplace_back("lru_k", std::make_unique<huadb::LRUKBufferStrategy>());
+  strategies.emplace_back("two_queue", std::make_unique<huadb::TwoQueueBufferStrategy>(options.buffer_size));
+
+  std::cout << "accesses: " << trace.size() << std::endl;
+  std::cout << std::left << std::setw(10) << "strategy" << std::setw(12) << "hits" << std::setw(12) << "misses"
+            << std::setw(12) << "hit ratio"
+            << "hot hit ratio" << std::endl;
+  for (auto &[name, strategy] : strategies) {
+    auto result = Replay(*strategy, options, trace);
+    std::cout << std::left << std::setw(10) << name << std::setw(12) << result.hits_ << std::setw(12)
+              << trace.size() - result.hits_ << std::fixed << std::setprecision(4) << std::setw(12)
+              << static_cast<double>(result.hits_) / trace.size()
+              << static_cast<double>(result.hot_hits_) / result.hot_accesses_ << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "argparse/argparse.hpp"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+// 行存表、列存表与压缩列存表的插入和扫描吞吐量对比
+// 对每种存储格式新建数据目录，通过 SQL 向多列的宽表批量插入记录，清空缓存后执行只用到两列的扫描，分别统计耗时
+// 行存表扫描在页面中的记录视图上判断过滤条件，但需读取整行所在的页面；列存表只读取查询用到的列，列数越多差距越大
+// 压缩列存表的页面写满后按列压缩，每个页面容纳更多记录，扫描读取的数据量更少，过滤条件直接在编码上判断
+
+struct BenchResult {
+  double insert_ms_;
+  double scan_ms_;
+  uint64_t scan_read_bytes_;
+  uint64_t table_bytes_;
+};
+
+std::string Execute(huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+uint64_t ShowCounter(huadb::Connection &connection, const std::string &variable) {
+  return std::stoull(Execute(connection, "show " + variable + ";"));
+}
+
+// 数据目录中最大的表文件的大小，即基准测试的表的大小，调用时工作目录为数据目录
+uint64_t TableSize() {
+  uint64_t size = 0;
+  for (const auto &entry : std::filesystem::recursive_directory_iterator(".")) {
+    auto name = entry.path().filename().string();
+    if (entry.is_regular_file() && std::all_of(name.begin(), name.end(), ::isdigit)) {
+      size = std::max<uint64_t>(size, entry.file_size());
+    }
+  }
+  return size;
+}
+
+BenchResult Run(const std::string &storage, size_t page_size, size_t buffer_size, size_t rows, size_t batch,
+                size_t columns) {
+  BenchResult result;
+  auto database = std::make_unique<huadb::DatabaseEngine>(buffer_size, huadb::IOEngineType::SYNC, false, page_size);
+  auto connection = std::make_unique<huadb::Connection>(*database);
+  std::string create = "create table bench(";
+  for (size_t column = 0; column < columns; column++) {
+    create += (column == 0 ? "c" : ", c") + std::to_string(column) + " int";
+  }
+  if (storage == "compressed") {
+    Execute(*connection, create + ") with (storage = columnar, compression = on);");
+  } else {
+    Execute(*connection, create + ") with (storage = '" + storage + "');");
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t first = 0; first < rows; first += batch) {
+    std::string sql = "insert into bench values ";
+    for (size_t id = first; id < std::min(rows, first + batch); id++) {
+      sql += id == first ? "(" : ", (";
+      // c1 为打乱顺序的偶数，每个页面中 c1 的上下界覆盖查询的值，区域映射无法跳过页面
+      for (size_t column = 0; column < columns; column++) {
+        auto value = column == 1 ? id * 7919 % 1000 * 2 : id + column;
+        sql += (column == 0 ? "" : ", ") + std::to_string(value);
+      }
+      sql += ")";
+    }
+    Execute(*connection, sql + ";");
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  result.insert_ms_ = elapsed.count();
+
+  // 从空缓存开始扫描，过滤条件不匹配任何记录，避免输出结果的开销
+  database->Flush();
+  auto read_bytes = ShowCounter(*connection, "read_bytes");
+  start = std::chrono::steady_clock::now();
+  Execute(*connection, "select c0 from bench where c1 = 999;");
+  elapsed = std::chrono::steady_clock::now() - start;
+  result.scan_ms_ = elapsed.count();
+  result.scan_read_bytes_ = ShowCounter(*connection, "read_bytes") - read_bytes;
+  result.table_bytes_ = TableSize();
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("columnar-bench");
+  program.add_argument("-b", "--buffer-size").default_value(size_t{1024}).scan<'u', size_t>();
+  program.add_argument("-r", "--rows").default_value(size_t{50000}).scan<'u', size_t>();
+  program.add_argument("-c", "--columns").help("Number of int columns").default_value(size_t{32}).scan<'u', size_t>();
+  program.add_argument("--batch").help("Rows per insert statement").default_value(size_t{100}).scan<'u', size_t>();
+  program.add_argument("--page-size").default_value(size_t{8192}).scan<'u', size_t>();
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+  auto buffer_size = program.get<size_t>("-b");
+  auto rows = program.get<size_t>("-r");
+  auto columns = program.get<size_t>("-c");
+  auto batch = program.get<size_t>("--batch");
+  auto page_size = program.get<size_t>("--page-size");
+  if (buffer_size == 0 || rows == 0 || columns < 2 || batch == 0) {
+    std::cerr << "buffer-size, rows and batch must be positive, columns must be at least 2" << std::endl;
+    std::exit(1);
+  }
+
+  // 在临时目录中生成数据，测试结束后删除
+  auto work_dir = std::filesystem::temp_directory_path() / ("huadb-columnar-bench-" + std::to_string(getpid()));
+  std::cout << "rows: " << rows << ", columns: " << columns << ", page size: " << page_size
+            << ", buffer size: " << buffer_size << std::endl;
+  std::cout << std::left << std::setw(12) << "storage" << std::setw(14) << "insert rows/s" << std::setw(14)
+            << "scan rows/s" << std::setw(10) << "scan MB"
+            << "table MB" << std::endl;
+  for (const std::string storage : {"row", "columnar", "compressed"}) {
+    std::filesystem::create_directory(work_dir);
+    std::filesystem::current_path(work_dir);
+    BenchResult result;
+    try {
+      result = Run(storage, page_size, buffer_size, rows, batch, columns);
+    } catch (std::exception &e) {
+      std::cerr << storage << ": " << e.what() << std::endl;
+      std::filesystem::current_path(work_dir.parent_path());
+      std::filesystem::remove_all(work_dir);
+      continue;
+    }
+    std::filesystem::current_path(work_dir.parent_path());
+    std::filesystem::remove_all(work_dir);
+
+    double megabytes = static_cast<double>(result.scan_read_bytes_) / (1 << 20);
+    double table_megabytes = static_cast<double>(result.table_bytes_) / (1 << 20);
+    std::cout << std::left << std::setw(12) << storage << std::fixed << std::setprecision(0) << std::setw(14)
+              << rows / result.insert_ms_ * 1000 << std::setw(14) << rows / result.scan_ms_ * 1000
+              << std::setprecision(2) << std::setw(10) << megabytes << table_megabytes << std::endl;
+  }
+  return 0;
+}
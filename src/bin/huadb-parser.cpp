@@ -27,11 +27,30 @@ void parse_control(const fs::path &path) {
   huadb::lsn_t lsn;
   huadb::oid_t oid;
   bool normal_shutdown;
+  size_t page_size;
   file >> xid >> lsn >> oid >> normal_shutdown;
+  if (!(file >> page_size)) {
+    page_size = huadb::DEFAULT_PAGE_SIZE;
+  }
   std::cout << "next xid: " << xid << std::endl;
   std::cout << "next lsn: " << lsn << std::endl;
   std::cout << "next oid: " << oid << std::endl;
   std::cout << "normal_shutdown: " << normal_shutdown << std::endl;
+  std::cout << "page size: " << page_size << std::endl;
+}
+
+// 表文件位于 数据目录/数据库oid/表oid，从数据目录的控制文件中读取页面大小，读取失败时使用默认页面大小
+size_t read_page_size(const fs::path &data_path) {
+  std::ifstream file(fs::absolute(data_path).parent_path().parent_path() / huadb::CONTROL_NAME);
+  huadb::xid_t xid;
+  huadb::lsn_t lsn;
+  huadb::oid_t oid;
+  bool normal_shutdown;
+  size_t page_size;
+  if (!(file >> xid >> lsn >> oid >> normal_shutdown >> page_size)) {
+    return huadb::DEFAULT_PAGE_SIZE;
+  }
+  return page_size;
 }
 
 void parse_data(const fs::path &path) {
@@ -44,20 +63,19 @@ void parse_data(const fs::path &path) {
     std::cerr << "Failed to open file: " << path << std::endl;
     std::exit(1);
   }
-  char buffer[huadb::DB_PAGE_SIZE];
+  auto page_size = read_page_size(path);
+  auto page = std::make_unique<huadb::Page>(page_size);
   huadb::pageid_t page_id = 0;
   while (!file.eof()) {
-    file.read(buffer, huadb::DB_PAGE_SIZE);
+    file.read(page->GetData(), page_size);
     if (file.gcount() == 0) {
       break;
     }
-    if (file.gcount() != huadb::DB_PAGE_SIZE) {
+    if (static_cast<size_t>(file.gcount()) != page_size) {
       std::cerr << "Incorrect page size" << std::endl;
       std::exit(1);
     }
-    auto page = std::make_unique<huadb::Page>();
-    memcpy(page->GetData(), buffer, huadb::DB_PAGE_SIZE);
-    huadb::TablePage table_page(std::move(page));
+    huadb::TablePage table_page(page.get());
     std::cout << "page id: " << page_id << std::endl;
     std::cout << table_page.ToString() << std::endl;
     page_id++;
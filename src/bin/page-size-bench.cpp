@@ -0,0 +1,133 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+// 页面大小对插入和顺序扫描吞吐量的影响
+// 对每个页面大小新建数据目录，通过 SQL 批量插入定长记录，清空缓存后顺序扫描全表，分别统计耗时
+// 页面越大，每个页面的页头和槽位开销占比越低，一次读写传输的记录越多，但单个页面的读写和拷贝开销越大
+
+struct BenchResult {
+  double insert_ms_;
+  double scan_ms_;
+  uint64_t scan_read_bytes_;
+};
+
+std::string Execute(huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+uint64_t ShowCounter(huadb::Connection &connection, const std::string &variable) {
+  return std::stoull(Execute(connection, "show " + variable + ";"));
+}
+
+BenchResult Run(size_t page_size, size_t buffer_size, size_t rows, size_t batch, size_t record_size) {
+  BenchResult result;
+  auto database = std::make_unique<huadb::DatabaseEngine>(buffer_size, huadb::IOEngineType::SYNC, false, page_size);
+  auto connection = std::make_unique<huadb::Connection>(*database);
+  Execute(*connection, "create table bench(id int, payload varchar(" + std::to_string(record_size) + "));");
+  std::string payload(record_size, 'x');
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t first = 0; first < rows; first += batch) {
+    std::string sql = "insert into bench values ";
+    for (size_t id = first; id < std::min(rows, first + batch); id++) {
+      if (id != first) {
+        sql += ", ";
+      }
+      sql += "(" + std::to_string(id) + ", '" + payload + "')";
+    }
+    Execute(*connection, sql + ";");
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  result.insert_ms_ = elapsed.count();
+
+  // 从空缓存开始扫描，过滤条件不匹配任何记录，避免输出结果的开销
+  database->Flush();
+  auto read_bytes = ShowCounter(*connection, "read_bytes");
+  start = std::chrono::steady_clock::now();
+  Execute(*connection, "select id from bench where id < 0;");
+  elapsed = std::chrono::steady_clock::now() - start;
+  result.scan_ms_ = elapsed.count();
+  result.scan_read_bytes_ = ShowCounter(*connection, "read_bytes") - read_bytes;
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("page-size-bench");
+  program.add_argument("-s", "--page-sizes")
+      .help("Comma separated page sizes to compare")
+      .default_value(std::string("256,4096,8192,16384,32768"));
+  program.add_argument("-b", "--buffer-size").default_value(size_t{1024}).scan<'u', size_t>();
+  program.add_argument("-r", "--rows").default_value(size_t{20000}).scan<'u', size_t>();
+  program.add_argument("--batch").help("Rows per insert statement").default_value(size_t{100}).scan<'u', size_t>();
+  program.add_argument("--record-size")
+      .help("Length of the varchar payload")
+      .default_value(size_t{100})
+      .scan<'u', size_t>();
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+  auto buffer_size = program.get<size_t>("-b");
+  auto rows = program.get<size_t>("-r");
+  auto batch = program.get<size_t>("--batch");
+  auto record_size = program.get<size_t>("--record-size");
+  if (buffer_size == 0 || rows == 0 || batch == 0) {
+    std::cerr << "buffer-size, rows and batch must be positive" << std::endl;
+    std::exit(1);
+  }
+  std::vector<size_t> page_sizes;
+  std::istringstream page_sizes_stream(program.get<std::string>("-s"));
+  for (std::string page_size; std::getline(page_sizes_stream, page_size, ',');) {
+    page_sizes.push_back(std::stoull(page_size));
+  }
+
+  // 在临时目录中生成数据，测试结束后删除
+  auto work_dir = std::filesystem::temp_directory_path() / ("huadb-page-size-bench-" + std::to_string(getpid()));
+  std::cout << "rows: " << rows << ", record size: " << record_size << ", buffer size: " << buffer_size << std::endl;
+  std::cout << std::left << std::setw(12) << "page size" << std::setw(14) << "insert rows/s" << std::setw(14)
+            << "scan rows/s" << std::setw(12) << "scan MB/s"
+            << "scan MB" << std::endl;
+  for (auto page_size : page_sizes) {
+    std::filesystem::create_directory(work_dir);
+    std::filesystem::current_path(work_dir);
+    BenchResult result;
+    try {
+      result = Run(page_size, buffer_size, rows, batch, record_size);
+    } catch (std::exception &e) {
+      std::cerr << "page size " << page_size << ": " << e.what() << std::endl;
+      std::filesystem::current_path(work_dir.parent_path());
+      std::filesystem::remove_all(work_dir);
+      continue;
+    }
+    std::filesystem::current_path(work_dir.parent_path());
+    std::filesystem::remove_all(work_dir);
+
+    double megabytes = static_cast<double>(result.scan_read_bytes_) / (1 << 20);
+    std::cout << std::left << std::setw(12) << page_size << std::fixed << std::setprecision(0) << std::setw(14)
+              << rows / result.insert_ms_ * 1000 << std::setw(14) << rows / result.scan_ms_ * 1000
+              << std::setprecision(2) << std::setw(12) << megabytes / result.scan_ms_ * 1000 << megabytes << std::endl;
+  }
+  return 0;
+}
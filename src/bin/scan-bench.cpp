@@ -0,0 +1,154 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/constants.h"
+#include "log/log_manager.h"
+#include "storage/buffer_pool.h"
+#include "storage/disk.h"
+#include "storage/mapped_file.h"
+#include "transaction/lock_manager.h"
+#include "transaction/transaction_manager.h"
+
+// 只读顺序扫描测试
+// 生成一个表文件，分别通过 buffer pool 和内存映射顺序读取全部页面并访问页面中的每个字节，比较扫描耗时
+// 表文件写入后位于操作系统的页缓存中，两种方式都不产生真正的磁盘读，比较的是系统调用、拷贝和缓存管理的开销
+
+static constexpr huadb::oid_t BENCH_DB_OID = huadb::PRESERVED_OID;
+static constexpr huadb::oid_t BENCH_TABLE_OID = huadb::PRESERVED_OID + 1;
+
+// 页面中所有字节之和，用于访问页面内容并校验两种扫描读到的数据一致
+uint64_t Checksum(const char *data, size_t page_size) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < page_size; i++) {
+    sum += static_cast<unsigned char>(data[i]);
+  }
+  return sum;
+}
+
+uint64_t BufferedScan(huadb::BufferPool &buffer_pool, size_t pages) {
+  auto ring = buffer_pool.CreateBulkReadRing(BENCH_DB_OID, BENCH_TABLE_OID);
+  uint64_t sum = 0;
+  for (size_t page_id = 0; page_id < pages; page_id++) {
+    if (ring != nullptr) {
+      ring->SetScanPosition(page_id);
+    }
+    auto guard = buffer_pool.FetchPageRead(BENCH_DB_OID, BENCH_TABLE_OID, page_id, ring.get());
+    sum += Checksum(guard.GetData(), buffer_pool.GetPageSize());
+  }
+  return sum;
+}
+
+uint64_t MappedScan(size_t pages, size_t page_size) {
+  huadb::MappedFile mapped(BENCH_DB_OID, BENCH_TABLE_OID, page_size);
+  uint64_t sum = 0;
+  for (size_t page_id = 0; page_id < pages; page_id++) {
+    auto guard = mapped.FetchPage(page_id);
+    sum += Checksum(guard.GetData(), page_size);
+  }
+  return sum;
+}
+
+// 重复执行扫描 rounds 次，返回最短耗时（毫秒）
+double Measure(size_t rounds, const std::function<uint64_t()> &scan, uint64_t &sum) {
+  double best = 0;
+  for (size_t round = 0; round < rounds; round++) {
+    auto start = std::chrono::steady_clock::now();
+    sum = scan();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (round == 0 || elapsed.count() < best) {
+      best = elapsed.count();
+    }
+  }
+  return best;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("scan-bench");
+  program.add_argument("-b", "--buffer-size").default_value(size_t{1024}).scan<'u', size_t>();
+  program.add_argument("-p", "--pages").default_value(size_t{65536}).scan<'u', size_t>();
+  program.add_argument("--read-ahead").default_value(size_t{8}).scan<'u', size_t>();
+  program.add_argument("--rounds").default_value(size_t{5}).scan<'u', size_t>();
+  program.add_argument("--page-size").default_value(huadb::DEFAULT_PAGE_SIZE).scan<'u', size_t>();
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+  auto buffer_size = program.get<size_t>("-b");
+  auto pages = program.get<size_t>("-p");
+  auto read_ahead = program.get<size_t>("--read-ahead");
+  auto rounds = program.get<size_t>("--rounds");
+  auto page_size = program.get<size_t>("--page-size");
+  if (buffer_size == 0 || pages == 0 || rounds == 0) {
+    std::cerr << "buffer-size, pages and rounds must be positive" << std::endl;
+    std::exit(1);
+  }
+
+  // 在临时目录中生成数据，测试结束后删除
+  auto work_dir = std::filesystem::temp_directory_path() / ("huadb-scan-bench-" + std::to_string(getpid()));
+  std::filesystem::create_directory(work_dir);
+  std::filesystem::current_path(work_dir);
+
+  uint64_t buffered_sum = 0;
+  uint64_t mapped_sum = 0;
+  double buffered_ms;
+  double mapped_ms;
+  {
+    huadb::Disk disk;
+    disk.SetPageSize(page_size);
+    huadb::LockManager lock_manager;
+    huadb::TransactionManager transaction_manager(lock_manager, huadb::FIRST_XID);
+    huadb::LogManager log_manager(disk, transaction_manager, huadb::FIRST_LSN);
+    huadb::Disk::CreateDirectory(std::to_string(BENCH_DB_OID));
+    huadb::Disk::CreateFile(huadb::Disk::GetFilePath(BENCH_DB_OID, BENCH_TABLE_OID));
+    std::mt19937 rng(2024);
+    std::vector<char> data(page_size);
+    for (size_t page_id = 0; page_id < pages; page_id++) {
+      std::generate(data.begin(), data.end(), [&rng]() { return static_cast<char>(rng()); });
+      disk.WritePage(BENCH_DB_OID, BENCH_TABLE_OID, page_id, data.data());
+    }
+
+    huadb::BufferPool buffer_pool(disk, log_manager, buffer_size);
+    buffer_pool.SetReadAheadPages(read_ahead);
+    buffered_ms = Measure(
+        rounds,
+        [&]() {
+          // 每轮从空缓存开始扫描
+          buffer_pool.Flush();
+          return BufferedScan(buffer_pool, pages);
+        },
+        buffered_sum);
+    mapped_ms = Measure(rounds, [&]() { return MappedScan(pages, page_size); }, mapped_sum);
+  }
+
+  std::filesystem::current_path(work_dir.parent_path());
+  std::filesystem::remove_all(work_dir);
+
+  if (buffered_sum != mapped_sum) {
+    std::cerr << "Checksum mismatch: buffered " << buffered_sum << ", mapped " << mapped_sum << std::endl;
+    std::exit(1);
+  }
+  double megabytes = static_cast<double>(pages) * page_size / (1 << 20);
+  std::cout << "pages: " << pages << ", page size: " << page_size << ", buffer size: " << buffer_size
+            << ", read ahead: " << read_ahead << std::endl;
+  std::cout << std::left << std::setw(10) << "mode" << std::setw(12) << "time (ms)"
+            << "MB/s" << std::endl;
+  std::cout << std::left << std::setw(10) << "buffered" << std::fixed << std::setprecision(2) << std::setw(12)
+            << buffered_ms << megabytes / buffered_ms * 1000 << std::endl;
+  std::cout << std::left << std::setw(10) << "mmap" << std::fixed << std::setprecision(2) << std::setw(12) << mapped_ms
+            << megabytes / mapped_ms * 1000 << std::endl;
+  return 0;
+}
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <thread>
 
+#include "argparse/argparse.hpp"
 #include "common/constants.h"
 #include "common/result_writer.h"
 #include "database/connection.h"
@@ -56,10 +57,45 @@ void client_handler(int client_socket, huadb::DatabaseEngine &database) {
   std::cout << "Client disconnected" << std::endl;
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("server");
+  program.add_argument("-b", "--buffer-pool-size")
+      .help("Number of frames in the buffer pool")
+      .default_value(huadb::DEFAULT_BUFFER_SIZE)
+      .metavar("SIZE")
+      .scan<'u', size_t>();
+  program.add_argument("--io-engine")
+      .help("I/O engine for batched page and log I/O (sync or io_uring), io_uring falls back to sync if unavailable")
+      .default_value(std::string("sync"))
+      .metavar("ENGINE");
+  program.add_argument("--direct-io")
+      .help("Read and write table files with O_DIRECT, bypassing the OS page cache")
+      .flag();
+  program.add_argument("--page-size")
+      .help("Page size in bytes when creating a new data directory (a power of 2 from 256 to 32768)")
+      .default_value(huadb::DEFAULT_PAGE_SIZE)
+      .metavar("SIZE")
+      .scan<'u', size_t>();
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+
   signal(SIGINT, sigint_handler);
 
-  auto database = std::make_unique<huadb::DatabaseEngine>();
+  auto io_engine = program.get<std::string>("--io-engine");
+  if (io_engine != "sync" && io_engine != "io_uring") {
+    std::cerr << "Unknown I/O engine " << io_engine << std::endl;
+    std::exit(1);
+  }
+  auto io_engine_type = io_engine == "io_uring" ? huadb::IOEngineType::IO_URING : huadb::IOEngineType::SYNC;
+  auto direct_io = program.get<bool>("--direct-io");
+  auto database = std::make_unique<huadb::DatabaseEngine>(program.get<size_t>("-b"), io_engine_type, direct_io,
+                                                          program.get<size_t>("--page-size"));
 
   int server_socket = socket(AF_UNIX, SOCK_STREAM, 0);
   if (server_socket == -1) {
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "argparse/argparse.hpp"
 #include "common/constants.h"
 #include "common/result_writer.h"
 #include "database/connection.h"
@@ -12,9 +13,9 @@
 
 namespace fs = std::filesystem;
 
-void PlainShell() {
+void PlainShell(size_t buffer_pool_size, huadb::IOEngineType io_engine_type, bool direct_io, size_t page_size) {
   std::string query;
-  auto database = std::make_unique<huadb::DatabaseEngine>();
+  auto database = std::make_unique<huadb::DatabaseEngine>(buffer_pool_size, io_engine_type, direct_io, page_size);
   auto connection = std::make_unique<huadb::Connection>(*database);
   while (std::getline(std::cin, query)) {
     try {
@@ -26,7 +27,7 @@ void PlainShell() {
         std::cout << "FLUSH" << std::endl;
       } else if (query.substr(0, 7) == "restart") {
         database.reset();
-        database = std::make_unique<huadb::DatabaseEngine>();
+        database = std::make_unique<huadb::DatabaseEngine>(buffer_pool_size, io_engine_type, direct_io, page_size);
         connection.reset();
         connection = std::make_unique<huadb::Connection>(*database);
         std::cout << "RESTART" << std::endl;
@@ -42,7 +43,8 @@ void PlainShell() {
   }
 }
 
-void LinenoiseShell() {
+void LinenoiseShell(size_t buffer_pool_size, huadb::IOEngineType io_engine_type, bool direct_io,
+                    size_t page_size) {
   std::string history_file;
   auto *home_dir = getenv("HOME");
   if (home_dir != nullptr) {
@@ -53,7 +55,7 @@ void LinenoiseShell() {
   linenoiseHistoryLoad(history_file.c_str());
   linenoiseHistorySetMaxLen(2048);
   linenoiseSetMultiLine(1);
-  auto database = std::make_unique<huadb::DatabaseEngine>();
+  auto database = std::make_unique<huadb::DatabaseEngine>(buffer_pool_size, io_engine_type, direct_io, page_size);
   auto connection = std::make_unique<huadb::Connection>(*database);
   while (true) {
     auto current_db = connection->GetCurrentDatabase();
@@ -90,7 +92,7 @@ void LinenoiseShell() {
         std::cout << "FLUSH" << std::endl;
       } else if (query.substr(0, 7) == "restart") {
         database.reset();
-        database = std::make_unique<huadb::DatabaseEngine>();
+        database = std::make_unique<huadb::DatabaseEngine>(buffer_pool_size, io_engine_type, direct_io, page_size);
         connection.reset();
         connection = std::make_unique<huadb::Connection>(*database);
         std::cout << "RESTART" << std::endl;
@@ -109,11 +111,48 @@ void LinenoiseShell() {
 }
 
 int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("shell");
+  program.add_argument("-s", "--simple").help("Read queries line by line without line editing").flag();
+  program.add_argument("-b", "--buffer-pool-size")
+      .help("Number of frames in the buffer pool")
+      .default_value(huadb::DEFAULT_BUFFER_SIZE)
+      .metavar("SIZE")
+      .scan<'u', size_t>();
+  program.add_argument("--io-engine")
+      .help("I/O engine for batched page and log I/O (sync or io_uring), io_uring falls back to sync if unavailable")
+      .default_value(std::string("sync"))
+      .metavar("ENGINE");
+  program.add_argument("--direct-io")
+      .help("Read and write table files with O_DIRECT, bypassing the OS page cache")
+      .flag();
+  program.add_argument("--page-size")
+      .help("Page size in bytes when creating a new data directory (a power of 2 from 256 to 32768)")
+      .default_value(huadb::DEFAULT_PAGE_SIZE)
+      .metavar("SIZE")
+      .scan<'u', size_t>();
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+
+  auto buffer_pool_size = program.get<size_t>("-b");
+  auto io_engine = program.get<std::string>("--io-engine");
+  if (io_engine != "sync" && io_engine != "io_uring") {
+    std::cerr << "Unknown I/O engine " << io_engine << std::endl;
+    std::exit(1);
+  }
+  auto io_engine_type = io_engine == "io_uring" ? huadb::IOEngineType::IO_URING : huadb::IOEngineType::SYNC;
+  auto direct_io = program.get<bool>("--direct-io");
+  auto page_size = program.get<size_t>("--page-size");
   std::cout << R"(Welcome to HuaDB. Type "\?" or "\h" for help.)" << std::endl;
-  if (argc > 1 && strcmp(argv[1], "-s") == 0) {
-    PlainShell();
+  if (program.get<bool>("-s")) {
+    PlainShell(buffer_pool_size, io_engine_type, direct_io, page_size);
   } else {
-    LinenoiseShell();
+    LinenoiseShell(buffer_pool_size, io_engine_type, direct_io, page_size);
   }
   return 0;
 }
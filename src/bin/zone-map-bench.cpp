@@ -0,0 +1,122 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "argparse/argparse.hpp"
+#include "common/result_writer.h"
+#include "database/connection.h"
+#include "database/database_engine.h"
+
+// 区域映射对按时间顺序追加的表的范围查询的影响
+// 通过 SQL 向表中按时间戳递增的顺序批量插入记录，清空缓存后分别在关闭和开启优化器时查询最近一段时间的记录
+// 关闭优化器时扫描不使用列取值范围，读取全部页面；开启时只读取区域映射表明可能包含满足条件的记录的页面
+
+struct BenchResult {
+  double scan_ms_;
+  uint64_t scan_read_bytes_;
+  uint64_t skipped_pages_;
+};
+
+std::string Execute(huadb::Connection &connection, const std::string &sql) {
+  std::ostringstream result;
+  huadb::SimpleWriter writer(result, true);
+  connection.SendQuery(sql, writer);
+  return result.str();
+}
+
+uint64_t ShowCounter(huadb::Connection &connection, const std::string &variable) {
+  return std::stoull(Execute(connection, "show " + variable + ";"));
+}
+
+BenchResult Scan(huadb::DatabaseEngine &database, huadb::Connection &connection, bool zone_map, size_t rows,
+                 size_t selected) {
+  BenchResult result;
+  Execute(connection, std::string("set enable_optimizer = ") + (zone_map ? "true" : "false") + ";");
+  // 从空缓存开始扫描
+  database.Flush();
+  auto read_bytes = ShowCounter(connection, "read_bytes");
+  auto skipped_pages = ShowCounter(connection, "zone_map_skipped_pages");
+  auto start = std::chrono::steady_clock::now();
+  Execute(connection, "select ts from events where ts >= " + std::to_string(rows - selected) + ";");
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  result.scan_ms_ = elapsed.count();
+  result.scan_read_bytes_ = ShowCounter(connection, "read_bytes") - read_bytes;
+  result.skipped_pages_ = ShowCounter(connection, "zone_map_skipped_pages") - skipped_pages;
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  argparse::ArgumentParser program("zone-map-bench");
+  program.add_argument("-b", "--buffer-size").default_value(size_t{1024}).scan<'u', size_t>();
+  program.add_argument("-r", "--rows").default_value(size_t{100000}).scan<'u', size_t>();
+  program.add_argument("-s", "--selected")
+      .help("Number of most recent rows the query selects")
+      .default_value(size_t{1000})
+      .scan<'u', size_t>();
+  program.add_argument("--batch").help("Rows per insert statement").default_value(size_t{100}).scan<'u', size_t>();
+  program.add_argument("--page-size").default_value(size_t{8192}).scan<'u', size_t>();
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+  auto buffer_size = program.get<size_t>("-b");
+  auto rows = program.get<size_t>("-r");
+  auto selected = program.get<size_t>("-s");
+  auto batch = program.get<size_t>("--batch");
+  auto page_size = program.get<size_t>("--page-size");
+  if (buffer_size == 0 || rows == 0 || batch == 0 || selected > rows) {
+    std::cerr << "buffer-size, rows and batch must be positive, selected must not exceed rows" << std::endl;
+    std::exit(1);
+  }
+
+  // 在临时目录中生成数据，测试结束后删除
+  auto work_dir = std::filesystem::temp_directory_path() / ("huadb-zone-map-bench-" + std::to_string(getpid()));
+  std::filesystem::create_directory(work_dir);
+  std::filesystem::current_path(work_dir);
+  BenchResult full_scan;
+  BenchResult pruned_scan;
+  try {
+    auto database = std::make_unique<huadb::DatabaseEngine>(buffer_size, huadb::IOEngineType::SYNC, false, page_size);
+    auto connection = std::make_unique<huadb::Connection>(*database);
+    Execute(*connection, "create table events(ts int, host varchar(16), value double);");
+    for (size_t first = 0; first < rows; first += batch) {
+      std::string sql = "insert into events values ";
+      for (size_t ts = first; ts < std::min(rows, first + batch); ts++) {
+        sql += ts == first ? "(" : ", (";
+        sql += std::to_string(ts) + ", 'host" + std::to_string(ts % 16) + "', " + std::to_string(ts % 100) + ".5)";
+      }
+      Execute(*connection, sql + ";");
+    }
+    full_scan = Scan(*database, *connection, false, rows, selected);
+    pruned_scan = Scan(*database, *connection, true, rows, selected);
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    std::filesystem::current_path(work_dir.parent_path());
+    std::filesystem::remove_all(work_dir);
+    std::exit(1);
+  }
+  std::filesystem::current_path(work_dir.parent_path());
+  std::filesystem::remove_all(work_dir);
+
+  std::cout << "rows: " << rows << ", selected: " << selected << ", page size: " << page_size
+            << ", buffer size: " << buffer_size << std::endl;
+  std::cout << std::left << std::setw(10) << "zone map" << std::setw(12) << "time (ms)" << std::setw(10) << "scan MB"
+            << "skipped pages" << std::endl;
+  for (const auto &[name, result] : {std::pair{"off", full_scan}, std::pair{"on", pruned_scan}}) {
+    double megabytes = static_cast<double>(result.scan_read_bytes_) / (1 << 20);
+    std::cout << std::left << std::setw(10) << name << std::fixed << std::setprecision(2) << std::setw(12)
+              << result.scan_ms_ << std::setw(10) << megabytes << result.skipped_pages_ << std::endl;
+  }
+  return 0;
+}
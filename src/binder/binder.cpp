@@ -27,6 +27,7 @@
 #include "binder/statements/statements.h"
 #include "binder/table_refs/table_refs.h"
 #include "catalog/column_definition.h"
+#include "catalog/system_view.h"
 #include "common/exceptions.h"
 #include "common/value.h"
 #include "nodes/parsenodes.hpp"
@@ -89,6 +90,9 @@ std::unique_ptr<Statement> Binder::BindCreateDatabaseStatement(duckdb_libpgquery
 
 std::unique_ptr<Statement> Binder::BindCreateTableStatement(duckdb_libpgquery::PGCreateStmt *stmt) {
   std::string table_name = stmt->relation->relname;
+  if (SystemView::IsSystemView(table_name)) {
+    throw DbException(fmt::format("Relation \"{}\" is a system view", table_name));
+  }
   auto columns = std::vector<ColumnDefinition>();
   std::unordered_set<std::string> column_names;
   for (auto *col = stmt->tableElts->head; col != nullptr; col = lnext(col)) {
@@ -109,7 +113,49 @@ std::unique_ptr<Statement> Binder::BindCreateTableStatement(duckdb_libpgquery::P
         throw DbException("Unsupported node type: " + NodeTagToString(node->type));
     }
   }
-  return std::make_unique<CreateTableStatement>(std::move(table_name), std::move(columns));
+  // 表选项 WITH (storage = row | columnar, compression = on | off)
+  auto storage_type = StorageType::ROW;
+  bool compression = false;
+  if (stmt->options != nullptr) {
+    for (auto *node = stmt->options->head; node != nullptr; node = lnext(node)) {
+      auto *elem = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(node->data.ptr_value);
+      // 不带引号的选项值解析为类型名，带引号的选项值和 on、true 等保留字解析为字符串
+      std::string value;
+      if (elem->arg != nullptr && elem->arg->type == duckdb_libpgquery::T_PGTypeName) {
+        auto *type_name = reinterpret_cast<duckdb_libpgquery::PGTypeName *>(elem->arg);
+        value = reinterpret_cast<duckdb_libpgquery::PGValue *>(type_name->names->tail->data.ptr_value)->val.str;
+      } else if (elem->arg != nullptr && elem->arg->type == duckdb_libpgquery::T_PGString) {
+        value = reinterpret_cast<duckdb_libpgquery::PGValue *>(elem->arg)->val.str;
+      }
+      if (strcasecmp(elem->defname, "storage") == 0) {
+        if (strcasecmp(value.c_str(), "row") == 0) {
+          storage_type = StorageType::ROW;
+        } else if (strcasecmp(value.c_str(), "columnar") == 0) {
+          storage_type = StorageType::COLUMNAR;
+        } else {
+          throw DbException("Unknown storage type: " + value);
+        }
+      } else if (strcasecmp(elem->defname, "compression") == 0) {
+        if (strcasecmp(value.c_str(), "on") == 0 || strcasecmp(value.c_str(), "true") == 0) {
+          compression = true;
+        } else if (strcasecmp(value.c_str(), "off") == 0 || strcasecmp(value.c_str(), "false") == 0) {
+          compression = false;
+        } else {
+          throw DbException("Unknown compression option: " + value);
+        }
+      } else {
+        throw DbException("Unknown table option: " + std::string(elem->defname));
+      }
+    }
+  }
+  // 压缩以列存页面为单位进行，行存表不支持压缩
+  if (compression) {
+    if (storage_type != StorageType::COLUMNAR) {
+      throw DbException("Compression requires columnar storage");
+    }
+    storage_type = StorageType::COMPRESSED_COLUMNAR;
+  }
+  return std::make_unique<CreateTableStatement>(std::move(table_name), std::move(columns), storage_type);
 }
 
 std::unique_ptr<Statement> Binder::BindCreateIndexStatement(duckdb_libpgquery::PGIndexStmt *stmt) {
@@ -176,6 +222,9 @@ std::unique_ptr<Statement> Binder::BindDropStatement(duckdb_libpgquery::PGDropSt
     case duckdb_libpgquery::PG_OBJECT_INDEX:
       return std::make_unique<DropIndexStatement>(name, stmt->missing_ok);
     case duckdb_libpgquery::PG_OBJECT_TABLE:
+      if (SystemView::IsSystemView(name)) {
+        throw DbException(fmt::format("Cannot drop system view \"{}\"", name));
+      }
       return std::make_unique<DropTableStatement>(name, stmt->missing_ok);
     default:
       throw DbException("Unknown catalog type");
@@ -695,9 +744,9 @@ std::unique_ptr<TableRef> Binder::BindFrom(duckdb_libpgquery::PGList *list) {
 
 std::unique_ptr<TableRef> Binder::BindRangeVar(duckdb_libpgquery::PGRangeVar *ref) {
   if (ref->alias != nullptr) {
-    return BindBaseTableRef(ref->relname, std::make_optional(ref->alias->aliasname));
+    return BindBaseTableRef(ref->relname, std::make_optional(ref->alias->aliasname), true);
   }
-  return BindBaseTableRef(ref->relname, std::nullopt);
+  return BindBaseTableRef(ref->relname, std::nullopt, true);
 }
 
 std::unique_ptr<TableRef> Binder::BindJoin(duckdb_libpgquery::PGJoinExpr *ref) {
@@ -742,7 +791,11 @@ std::unique_ptr<TableRef> Binder::BindJoin(duckdb_libpgquery::PGJoinExpr *ref) {
   return join_ref;
 }
 
-std::unique_ptr<BaseTableRef> Binder::BindBaseTableRef(std::string table_name, std::optional<std::string> alias) {
+std::unique_ptr<BaseTableRef> Binder::BindBaseTableRef(std::string table_name, std::optional<std::string> alias,
+                                                       bool allow_view) {
+  if (SystemView::IsSystemView(table_name) && !allow_view) {
+    throw DbException(fmt::format("Cannot modify system view \"{}\"", table_name));
+  }
   if (alias) {
     if (table_names_.find(*alias) != table_names_.end()) {
       throw DbException(fmt::format("Table name \"{}\" specified more than once", *alias));
@@ -754,6 +807,11 @@ std::unique_ptr<BaseTableRef> Binder::BindBaseTableRef(std::string table_name, s
     }
     table_names_.insert(table_name);
   }
+  if (SystemView::IsSystemView(table_name)) {
+    auto oid = SystemView::GetOid(table_name);
+    return std::make_unique<BaseTableRef>(std::move(table_name), std::move(alias), oid,
+                                          SystemView::GetColumnList(oid));
+  }
   auto oid = catalog_.GetTableOid(table_name);
   auto column_list = catalog_.GetTableColumnList(table_name);
   return std::make_unique<BaseTableRef>(std::move(table_name), std::move(alias), oid, column_list);
@@ -136,7 +136,9 @@ class Binder {
   std::unique_ptr<TableRef> BindJoin(duckdb_libpgquery::PGJoinExpr *ref);
 
   ColumnDefinition BindColumnDefinition(duckdb_libpgquery::PGColumnDef *col_def);
-  std::unique_ptr<BaseTableRef> BindBaseTableRef(std::string table_name, std::optional<std::string> alias);
+  // allow_view 为 true 时允许绑定系统视图，仅用于查询语句的 FROM 子句
+  std::unique_ptr<BaseTableRef> BindBaseTableRef(std::string table_name, std::optional<std::string> alias,
+                                                 bool allow_view = false);
   std::vector<std::unique_ptr<Expression>> BindSelectList(duckdb_libpgquery::PGList *list);
   std::unique_ptr<ExpressionListRef> BindValuesList(duckdb_libpgquery::PGList *list);
 
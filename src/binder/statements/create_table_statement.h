@@ -3,19 +3,28 @@
 #include <string>
 
 #include "binder/statement.h"
+#include "common/types.h"
 #include "fmt/ranges.h"
 
 namespace huadb {
 
 class CreateTableStatement : public Statement {
  public:
-  CreateTableStatement(std::string table, std::vector<ColumnDefinition> columns)
-      : Statement(StatementType::CREATE_TABLE_STATEMENT), table_(std::move(table)), columns_(std::move(columns)) {}
+  CreateTableStatement(std::string table, std::vector<ColumnDefinition> columns,
+                       StorageType storage_type = StorageType::ROW)
+      : Statement(StatementType::CREATE_TABLE_STATEMENT),
+        table_(std::move(table)),
+        columns_(std::move(columns)),
+        storage_type_(storage_type) {}
   std::string ToString() const override {
-    return fmt::format("CreateTableStatement: table={} columns={}\n", table_, columns_);
+    return fmt::format("CreateTableStatement: table={} columns={} storage={}\n", table_, columns_,
+                       storage_type_ == StorageType::ROW        ? "row"
+                       : storage_type_ == StorageType::COLUMNAR ? "columnar"
+                                                                : "compressed columnar");
   }
   std::string table_;
   std::vector<ColumnDefinition> columns_;
+  StorageType storage_type_;
 };
 
 }  // namespace huadb
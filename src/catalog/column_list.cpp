@@ -74,4 +74,10 @@ void ColumnList::FromString(const std::string &str) {
   }
 }
 
+void ColumnList::SetExternalReader(std::shared_ptr<const ExternalReader> reader) {
+  external_reader_ = std::move(reader);
+}
+
+const std::shared_ptr<const ExternalReader> &ColumnList::GetExternalReader() const { return external_reader_; }
+
 }  // namespace huadb
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include "catalog/column_definition.h"
+#include "common/value.h"
 
 namespace huadb {
 
@@ -33,10 +35,15 @@ class ColumnList {
   // 字符串格式反序列化
   void FromString(const std::string &str);
 
+  // 行外存储值的读取器，由表设置，反序列化记录时交给其中行外存储的值，不参与序列化
+  void SetExternalReader(std::shared_ptr<const ExternalReader> reader);
+  const std::shared_ptr<const ExternalReader> &GetExternalReader() const;
+
  private:
   std::vector<ColumnDefinition> columns_;
   // 列名到列索引的映射表
   std::unordered_map<std::string, size_t> col2idx_;
+  std::shared_ptr<const ExternalReader> external_reader_;
 };
 
 }  // namespace huadb
@@ -1,10 +1,12 @@
 #include "catalog/simple_catalog.h"
 
 #include <cassert>
+#include <fstream>
 #include <string>
 
 #include "common/constants.h"
 #include "common/exceptions.h"
+#include "table/pax_page.h"
 #include "table/table.h"
 
 namespace huadb {
@@ -40,7 +42,8 @@ void SimpleCatalog::LoadSystemTables() {
     std::ifstream table_in(std::to_string(current_database_oid_) + "/" + table_name + ".meta");
     oid_t oid, db_oid;
     std::string name, desc;
-    table_in >> oid >> db_oid >> name;
+    uint32_t storage_type;
+    table_in >> oid >> db_oid >> name >> storage_type;
     while (!table_in.eof()) {
       std::string tmp;
       table_in >> tmp;
@@ -49,7 +52,7 @@ void SimpleCatalog::LoadSystemTables() {
     }
     ColumnList column_list;
     column_list.FromString(desc);
-    CreateTable(name, column_list, oid, db_oid, false);
+    CreateTable(name, column_list, oid, db_oid, false, static_cast<StorageType>(storage_type));
   }
 }
 
@@ -74,7 +77,7 @@ void SimpleCatalog::ChangeDatabase(const std::string &database_name) {
 }
 
 void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid, oid_t db_oid,
-                                bool new_table) {
+                                bool new_table, StorageType storage_type) {
   // Step1. 约束检测
   if (db_oid == INVALID_OID) {
     db_oid = current_database_oid_;
@@ -82,6 +85,9 @@ void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList
   if (oid_manager_.EntryExists(OidType::TABLE, table_name)) {
     throw DbException("Table \"" + table_name + "\" already exists");
   }
+  if (storage_type != StorageType::ROW && PaxPage::GetCapacity(column_list, buffer_pool_.GetPageSize()) == 0) {
+    throw DbException("Row too wide for columnar storage");
+  }
   // Step2. OidManager添加对应项
   if (oid == INVALID_OID) {
     oid = oid_manager_.CreateEntry(OidType::TABLE, table_name);
@@ -98,7 +104,7 @@ void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList
   }
   name2oid_[table_name] = oid;
   oid2table_[oid] = std::make_shared<Table>(buffer_pool_, log_manager_, oid, db_oid, column_list, new_table,
-                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)));
+                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)), storage_type);
 
   // 检查：非新表不需要添加到Meta中
   if (!new_table) {
@@ -107,7 +113,8 @@ void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList
 
   // Step4. 写入到持久化文件table_name.meta
   std::ofstream out(std::to_string(current_database_oid_) + "/" + table_name + ".meta");
-  out << oid << " " << current_database_oid_ << " " << table_name << " " << column_list.ToString();
+  out << oid << " " << current_database_oid_ << " " << table_name << " " << static_cast<uint32_t>(storage_type) << " "
+      << column_list.ToString();
   std::ofstream db_out(std::to_string(current_database_oid_) + "/tables", std::ios::app);
   db_out << table_name << " ";
 }
@@ -120,7 +127,10 @@ void SimpleCatalog::DropTable(const std::string &table_name) {
   oid_t table_oid = oid_manager_.GetEntryOid(OidType::TABLE, table_name);
   // Step2. 实际删除表
   // 磁盘中删除对应项
+  buffer_pool_.CloseFile(current_database_oid_, table_oid);
   Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, table_oid));
+  buffer_pool_.CloseFile(current_database_oid_, table_oid | OVERFLOW_OID_FLAG);
+  Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, table_oid | OVERFLOW_OID_FLAG));
   name2oid_.erase(table_name);
   oid2table_.erase(table_oid);
 
@@ -35,9 +35,9 @@ class SimpleCatalog {
   // 获取表所在的数据库的oid
   oid_t GetDatabaseOid(oid_t table_oid) const;
 
-  // 创建表
+  // 创建表，storage_type 为表的存储格式
   void CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid = INVALID_OID,
-                   oid_t db_oid = INVALID_OID, bool new_table = true);
+                   oid_t db_oid = INVALID_OID, bool new_table = true, StorageType storage_type = StorageType::ROW);
   // 删除表
   void DropTable(const std::string &table_name);
   // 创建索引
@@ -6,6 +6,7 @@
 #include "common/constants.h"
 #include "common/exceptions.h"
 #include "common/value.h"
+#include "table/pax_page.h"
 #include "table/record.h"
 #include "table/table.h"
 #include "table/table_scan.h"
@@ -108,6 +109,7 @@ void SystemCatalog::DropDatabase(const std::string &database_name, bool missing_
   // Step 5. OidManager 删除对应项
   oid_manager_.DropEntry(OidType::DATABASE, database_name);
   // Step 6. 实际删除数据库的文件夹
+  buffer_pool_.CloseDatabaseFiles(db_oid);
   if (Disk::DirectoryExists(std::to_string(db_oid))) {
     Disk::RemoveDirectory(std::to_string(db_oid));
   }
@@ -172,7 +174,7 @@ oid_t SystemCatalog::GetDatabaseOid(oid_t table_oid) const {
 }
 
 void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid, oid_t db_oid,
-                                bool new_table) {
+                                bool new_table, StorageType storage_type) {
   // Step 1. 约束检测
   if (db_oid == INVALID_OID) {
     CheckUsingDatabase();
@@ -181,6 +183,9 @@ void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList
   if (oid_manager_.EntryExists(OidType::TABLE, table_name)) {
     throw DbException("Table \"" + table_name + "\" already exists");
   }
+  if (storage_type != StorageType::ROW && PaxPage::GetCapacity(column_list, buffer_pool_.GetPageSize()) == 0) {
+    throw DbException("Row too wide for columnar storage");
+  }
   // Step 2. OidManager 添加对应项
   if (oid == INVALID_OID) {
     oid = oid_manager_.CreateEntry(OidType::TABLE, table_name);
@@ -196,7 +201,7 @@ void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList
     Disk::CreateFile(Disk::GetFilePath(db_oid, oid));
   }
   oid2table_[oid] = std::make_shared<Table>(buffer_pool_, log_manager_, oid, db_oid, column_list, new_table,
-                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)));
+                                            Disk::EmptyFile(Disk::GetFilePath(db_oid, oid)), storage_type);
 
   // 检查：非新表不需要添加到 Meta 中
   if (!new_table) {
@@ -211,6 +216,7 @@ void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList
   values.emplace_back(table_name);
   values.emplace_back(column_list.ToString());
   values.emplace_back(INVALID_CARDINALITY);
+  values.emplace_back(static_cast<uint32_t>(storage_type));
   GetTable(TABLE_META_OID)->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
 }
 
@@ -224,7 +230,10 @@ void SystemCatalog::DropTable(const std::string &table_name) {
   oid_t table_oid = oid_manager_.GetEntryOid(OidType::TABLE, table_name);
   // Step 2. 实际删除表
   // 磁盘中删除对应项
+  buffer_pool_.CloseFile(current_database_oid_, table_oid);
   Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, table_oid));
+  buffer_pool_.CloseFile(current_database_oid_, table_oid | OVERFLOW_OID_FLAG);
+  Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, table_oid | OVERFLOW_OID_FLAG));
   oid2table_.erase(table_oid);
 
   // Step 3. OidManager 删除对应项
@@ -421,6 +430,7 @@ void SystemCatalog::LoadTableMeta() {
   auto table_name_idx = table_meta_schema.GetColumnIndex("table_name");
   auto schema_idx = table_meta_schema.GetColumnIndex("schema");
   auto cardinality_idx = table_meta_schema.GetColumnIndex("cardinality");
+  auto storage_idx = table_meta_schema.GetColumnIndex("storage");
   while (auto record = scan->GetNextRecord()) {
     if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_) {
       // 读取数据表信息
@@ -428,13 +438,15 @@ void SystemCatalog::LoadTableMeta() {
       auto table_name = record->GetValue(table_name_idx).GetValue<std::string>();
       auto column_list_string = record->GetValue(schema_idx).GetValue<std::string>();
       auto cardinality = record->GetValue(cardinality_idx).GetValue<uint32_t>();
+      auto storage_type = static_cast<StorageType>(record->GetValue(storage_idx).GetValue<uint32_t>());
       ColumnList column_list;
       column_list.FromString(column_list_string);
 
       // 添加数据表
       oid_manager_.SetEntryOid(OidType::TABLE, table_name, oid);
-      oid2table_[oid] = std::make_shared<Table>(buffer_pool_, log_manager_, oid, current_database_oid_, column_list,
-                                                false, Disk::EmptyFile(Disk::GetFilePath(GetDatabaseOid(oid), oid)));
+      oid2table_[oid] =
+          std::make_shared<Table>(buffer_pool_, log_manager_, oid, current_database_oid_, column_list, false,
+                                  Disk::EmptyFile(Disk::GetFilePath(GetDatabaseOid(oid), oid)), storage_type);
       table2cardinality_[table_name] = cardinality;
     }
   }
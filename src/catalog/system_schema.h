@@ -7,7 +7,8 @@ ColumnList table_meta_schema({ColumnDefinition("table_oid", Type::UINT),
                               ColumnDefinition("db_oid", Type::UINT),
                               ColumnDefinition("table_name", Type::VARCHAR, 32),
                               ColumnDefinition("schema", Type::VARCHAR, 1024),
-                              ColumnDefinition("cardinality", Type::UINT)});
+                              ColumnDefinition("cardinality", Type::UINT),
+                              ColumnDefinition("storage", Type::UINT)});
 ColumnList database_meta_schema({ColumnDefinition("db_oid", Type::UINT),
                                  ColumnDefinition("db_name", Type::VARCHAR, 32)});
 ColumnList statistic_schema({ColumnDefinition("table_name", Type::VARCHAR, 32),
@@ -0,0 +1,48 @@
+#include "catalog/system_view.h"
+
+#include "common/constants.h"
+#include "common/exceptions.h"
+
+namespace huadb {
+
+// 统计值为 INT 类型，超出 INT 的范围时取 INT 的最大值
+// clang-format off
+static const ColumnList stat_buffer_schema({ColumnDefinition("table_oid", Type::INT),
+                                            ColumnDefinition("db_oid", Type::INT),
+                                            ColumnDefinition("table_name", Type::VARCHAR, 32),
+                                            ColumnDefinition("hits", Type::INT),
+                                            ColumnDefinition("misses", Type::INT),
+                                            ColumnDefinition("evictions", Type::INT),
+                                            ColumnDefinition("dirty_writes", Type::INT),
+                                            ColumnDefinition("read_bytes", Type::INT),
+                                            ColumnDefinition("write_bytes", Type::INT)});
+static const ColumnList stat_io_schema({ColumnDefinition("operation", Type::VARCHAR, 16),
+                                        ColumnDefinition("latency", Type::VARCHAR, 16),
+                                        ColumnDefinition("count", Type::INT)});
+// clang-format on
+
+bool SystemView::IsSystemView(const std::string &view_name) {
+  return view_name == STAT_BUFFER_VIEW_NAME || view_name == STAT_IO_VIEW_NAME;
+}
+
+bool SystemView::IsSystemView(oid_t oid) { return oid == STAT_BUFFER_VIEW_OID || oid == STAT_IO_VIEW_OID; }
+
+oid_t SystemView::GetOid(const std::string &view_name) {
+  if (view_name == STAT_BUFFER_VIEW_NAME) {
+    return STAT_BUFFER_VIEW_OID;
+  } else if (view_name == STAT_IO_VIEW_NAME) {
+    return STAT_IO_VIEW_OID;
+  }
+  throw DbException("\"" + view_name + "\" is not a system view");
+}
+
+const ColumnList &SystemView::GetColumnList(oid_t oid) {
+  if (oid == STAT_BUFFER_VIEW_OID) {
+    return stat_buffer_schema;
+  } else if (oid == STAT_IO_VIEW_OID) {
+    return stat_io_schema;
+  }
+  throw DbException("oid " + std::to_string(oid) + " is not a system view");
+}
+
+}  // namespace huadb
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+#include "catalog/column_list.h"
+#include "common/types.h"
+
+namespace huadb {
+
+// 系统视图，可以像表一样查询，但不能修改
+// 系统视图没有表文件，查询时由执行器根据运行时统计信息生成记录：
+// huadb_stat_buffer 每行为一个表的缓存与磁盘读写统计，huadb_stat_io 每行为一种 I/O 的一个延迟区间的次数
+class SystemView {
+ public:
+  static bool IsSystemView(const std::string &view_name);
+  static bool IsSystemView(oid_t oid);
+  // 获取视图的 oid，不是系统视图时抛出异常
+  static oid_t GetOid(const std::string &view_name);
+  // 获取视图的 schema 信息，不是系统视图时抛出异常
+  static const ColumnList &GetColumnList(oid_t oid);
+};
+
+}  // namespace huadb
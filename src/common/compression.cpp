@@ -0,0 +1,114 @@
+#include "common/compression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+// 最远回溯距离、最短和最长匹配长度
+static constexpr size_t LZ_MAX_OFFSET = 4095;
+static constexpr size_t LZ_MIN_MATCH = 3;
+static constexpr size_t LZ_MAX_MATCH = LZ_MIN_MATCH + 15 + 255;
+// 以 3 字节前缀查找匹配位置的哈希表大小
+static constexpr size_t LZ_HASH_SIZE = 4096;
+
+static size_t LzHash(const unsigned char *data) {
+  return ((data[0] << 6) ^ (data[1] << 3) ^ data[2]) & (LZ_HASH_SIZE - 1);
+}
+
+std::string Compression::LzCompress(const std::string &data) {
+  const auto *input = reinterpret_cast<const unsigned char *>(data.data());
+  size_t size = data.size();
+  std::string result;
+  result.reserve(size + size / 8 + 1);
+  // 每个哈希值最近一次出现的位置
+  std::vector<int64_t> last_pos(LZ_HASH_SIZE, -1);
+  size_t control_pos = 0;
+  size_t item = 8;
+  size_t pos = 0;
+  while (pos < size) {
+    if (item == 8) {
+      control_pos = result.size();
+      result.push_back(0);
+      item = 0;
+    }
+    size_t match_len = 0;
+    size_t match_offset = 0;
+    if (pos + LZ_MIN_MATCH <= size) {
+      auto hash = LzHash(input + pos);
+      auto candidate = last_pos[hash];
+      last_pos[hash] = pos;
+      if (candidate >= 0 && pos - candidate <= LZ_MAX_OFFSET) {
+        size_t max_len = std::min(LZ_MAX_MATCH, size - pos);
+        while (match_len < max_len && input[candidate + match_len] == input[pos + match_len]) {
+          match_len++;
+        }
+        match_offset = pos - candidate;
+      }
+    }
+    if (match_len >= LZ_MIN_MATCH) {
+      result[control_pos] |= static_cast<char>(1 << item);
+      size_t len_code = match_len - LZ_MIN_MATCH;
+      result.push_back(static_cast<char>(((match_offset >> 4) & 0xf0) | std::min<size_t>(len_code, 15)));
+      result.push_back(static_cast<char>(match_offset & 0xff));
+      if (len_code >= 15) {
+        result.push_back(static_cast<char>(len_code - 15));
+      }
+      // 匹配范围内的位置也加入哈希表，供之后的匹配使用
+      for (size_t i = pos + 1; i < pos + match_len && i + LZ_MIN_MATCH <= size; i++) {
+        last_pos[LzHash(input + i)] = i;
+      }
+      pos += match_len;
+    } else {
+      result.push_back(static_cast<char>(input[pos]));
+      pos++;
+    }
+    item++;
+  }
+  return result;
+}
+
+std::string Compression::LzDecompress(const char *data, size_t size, size_t raw_size) {
+  const auto *input = reinterpret_cast<const unsigned char *>(data);
+  std::string result;
+  result.reserve(raw_size);
+  size_t pos = 0;
+  while (pos < size && result.size() < raw_size) {
+    unsigned char control = input[pos++];
+    for (size_t item = 0; item < 8 && pos < size && result.size() < raw_size; item++) {
+      if ((control & (1 << item)) == 0) {
+        result.push_back(static_cast<char>(input[pos++]));
+        continue;
+      }
+      if (pos + 2 > size) {
+        throw DbException("Corrupted compressed data");
+      }
+      size_t len = (input[pos] & 0x0f) + LZ_MIN_MATCH;
+      size_t offset = ((input[pos] & 0xf0) << 4) | input[pos + 1];
+      pos += 2;
+      if (len == LZ_MIN_MATCH + 15) {
+        if (pos >= size) {
+          throw DbException("Corrupted compressed data");
+        }
+        len += input[pos++];
+      }
+      if (offset == 0 || offset > result.size() || result.size() + len > raw_size) {
+        throw DbException("Corrupted compressed data");
+      }
+      // 匹配可能与正在输出的数据重叠，逐字节复制
+      size_t start = result.size() - offset;
+      for (size_t i = 0; i < len; i++) {
+        result.push_back(result[start + i]);
+      }
+    }
+  }
+  if (pos != size || result.size() != raw_size) {
+    throw DbException("Corrupted compressed data");
+  }
+  return result;
+}
+
+}  // namespace huadb
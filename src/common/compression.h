@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace huadb {
+
+// 简单的 LZ77 压缩，用于压缩行外存储的长字符串
+// 压缩数据由若干组组成，每组以一个控制字节开头，其 8 个位（从低位开始）依次表示之后的 8 项是字面字节还是匹配
+// 匹配为 2 字节（长度不超过 17 时）或 3 字节：12 位的回溯距离和 4 位的长度，长度为 18 或更长时第 3 个字节为剩余长度
+class Compression {
+ public:
+  // 压缩数据，返回压缩结果，结果可能比原数据更长
+  static std::string LzCompress(const std::string &data);
+  // 解压 size 字节的压缩数据，raw_size 为原数据长度，数据损坏时抛出异常
+  static std::string LzDecompress(const char *data, size_t size, size_t raw_size);
+};
+
+}  // namespace huadb
@@ -20,17 +20,79 @@ static constexpr const char *BASE_PATH = "huadb_data";
 static constexpr const char *LOG_NAME = "log";
 static constexpr const char *INIT_NAME = "init";
 static constexpr const char *CONTROL_NAME = "control";
+static constexpr const char *WARMUP_NAME = "warmup";
 static constexpr const char *NEXT_LSN_NAME = "next_lsn";
 static constexpr const char *MASTER_RECORD_NAME = "master_record";
 
 static constexpr size_t LOG_SEGMENT_SIZE = (1 << 20);
-static constexpr size_t DB_PAGE_SIZE = (1 << 8);
-static constexpr size_t MAX_RECORD_SIZE = 230;
+// 表文件按区间预分配磁盘空间，第一个区间为 FILE_EXTENT_PAGES 个页面，之后每个区间与已分配的页面数目相同，
+// 最多为 MAX_FILE_EXTENT_PAGES 个页面
+static constexpr size_t FILE_EXTENT_PAGES = 64;
+static constexpr size_t MAX_FILE_EXTENT_PAGES = 1024;
+// 页面大小在创建数据目录时确定并记录在控制文件中，需为 2 的幂，范围为 [MIN_PAGE_SIZE, MAX_PAGE_SIZE]
+// 默认页面较小，便于在实验中观察多页面的行为
+static constexpr size_t MIN_PAGE_SIZE = (1 << 8);
+static constexpr size_t MAX_PAGE_SIZE = (1 << 15);
+static constexpr size_t DEFAULT_PAGE_SIZE = MIN_PAGE_SIZE;
+// 页面中不能用于存放记录的空间，记录最长长度为页面大小减去该值
+static constexpr size_t PAGE_RESERVED_SIZE = 26;
 // 日志记录最长长度
 static constexpr size_t MAX_LOG_SIZE = sizeof(enum_t) + sizeof(xid_t) + sizeof(lsn_t) + sizeof(oid_t) + sizeof(oid_t) +
                                        sizeof(pageid_t) + sizeof(slotid_t) + sizeof(db_size_t) + sizeof(db_size_t) +
-                                       MAX_RECORD_SIZE + sizeof(lsn_t);
-static constexpr size_t BUFFER_SIZE = 5;
+                                       (MAX_PAGE_SIZE - PAGE_RESERVED_SIZE) + sizeof(lsn_t);
+// buffer pool 默认页帧数目，可在启动时或通过 set buffer_pool_size 修改
+static constexpr size_t DEFAULT_BUFFER_SIZE = 5;
+// 系统表缓存的默认页帧数目，系统表页面只在这些页帧中替换，不与普通表页面竞争页帧
+static constexpr size_t DEFAULT_CATALOG_BUFFER_SIZE = 64;
+// 系统表缓存的最少页帧数目，保证修改系统表时同时 pin 住的页面有页帧可用
+static constexpr size_t MIN_CATALOG_BUFFER_SIZE = 4;
+// buffer pool 页帧内存的对齐大小，与操作系统页面大小一致
+static constexpr size_t FRAME_ALIGNMENT = 4096;
+// O_DIRECT 要求缓冲区地址、读写长度和文件偏移按逻辑块大小对齐，页面大小为其整数倍时才能启用直接 I/O
+static constexpr size_t DIRECT_IO_ALIGNMENT = 512;
+static constexpr size_t INVALID_FRAME_ID = -1;
+// buffer pool 页表的最大分区数目，每个分区有独立的锁、页帧和替换策略
+static constexpr size_t MAX_BUFFER_PARTITIONS = 16;
+// 每个分区的最少页帧数目，页帧较少时减少分区数目，避免分区内替换失去意义
+static constexpr size_t MIN_PARTITION_FRAMES = 64;
+// 后台写线程的唤醒间隔（毫秒）
+static constexpr size_t BGWRITER_INTERVAL_MS = 50;
+// 预读线程数目
+static constexpr size_t READ_AHEAD_WORKERS = 2;
+// 预读请求队列的最大长度，队列满时新的预读请求被丢弃
+static constexpr size_t MAX_READ_AHEAD_REQUESTS = 64;
+// 页帧环的页帧数目，大表顺序扫描、ANALYZE 和批量插入只在这些页帧中循环使用
+static constexpr size_t BUFFER_RING_FRAMES = 16;
+// 表的页面数目超过缓存页帧数目的 1/BULK_ACCESS_FRACTION 时，顺序扫描使用页帧环
+// 页帧环超过缓存的 1/BULK_ACCESS_FRACTION 时（缓存过小）不使用页帧环
+static constexpr size_t BULK_ACCESS_FRACTION = 4;
+// io_uring 队列深度，即批量读写时同时在途的最大请求数
+static constexpr unsigned IO_QUEUE_DEPTH = 64;
+// 批量写页面时合并为一次向量化写入的最大相邻页面数目，不超过 IOV_MAX
+static constexpr size_t MAX_COALESCED_PAGES = 64;
+// 空闲空间映射中页面剩余空间的等级数目，每个页面的等级占 1 字节
+static constexpr size_t FSM_CATEGORIES = 256;
+// 空闲空间映射文件的后缀，文件与表文件位于同一目录
+static constexpr const char *FSM_SUFFIX = ".fsm";
+// 可见性映射文件的后缀，文件与表文件位于同一目录
+static constexpr const char *VM_SUFFIX = ".vm";
+// 区域映射文件的后缀，文件与表文件位于同一目录
+static constexpr const char *ZONE_MAP_SUFFIX = ".zm";
+// 区域映射只记录最大长度不超过该值的 CHAR 和 VARCHAR 列，更长的列上下界占用空间大且很少用于范围查询
+static constexpr db_size_t ZONE_MAP_MAX_STRING_SIZE = 32;
+// 表的溢出页面存放在单独的溢出文件中，文件名为表文件名加该后缀
+// 溢出文件在 buffer pool 和日志中以表的 oid 加上 OVERFLOW_OID_FLAG 标识，与表文件区分
+static constexpr const char *OVERFLOW_SUFFIX = ".ovf";
+static constexpr oid_t OVERFLOW_OID_FLAG = 0x80000000;
+// 溢出页面头部只有 page lsn，其余空间存放值的数据
+static constexpr size_t OVERFLOW_PAGE_HEADER_SIZE = sizeof(lsn_t);
+// 行外存储的字符串值在记录中以长度字段的最高位标记，之后为定长的溢出指针
+// 行内字符串长度小于页面大小的最大值，不会用到最高位
+static constexpr db_size_t EXTERNAL_VALUE_FLAG = 0x8000;
+// 溢出指针：值在溢出文件中的起始位置(4) + 存储长度(4) + 原始长度(4)，两个长度不同时数据经过压缩
+static constexpr db_size_t EXTERNAL_POINTER_SIZE = 12;
+// 溢出值压缩后至少节省该比例（百分比）的空间时才保存压缩后的数据
+static constexpr size_t OVERFLOW_MIN_COMPRESSION_SAVING = 25;
 
 static constexpr lsn_t FIRST_LSN = 0;
 static constexpr lsn_t NULL_LSN = -1;
@@ -54,6 +116,9 @@ static constexpr oid_t TEMP_DATABASE_OID = 2;
 static constexpr oid_t TABLE_META_OID = 501;
 static constexpr oid_t DATABASE_META_OID = 502;
 static constexpr oid_t STATISTIC_META_OID = 503;
+// 系统视图没有表文件，查询时生成记录
+static constexpr oid_t STAT_BUFFER_VIEW_OID = 504;
+static constexpr oid_t STAT_IO_VIEW_OID = 505;
 
 static constexpr uint32_t INVALID_CARDINALITY = -1;
 static constexpr uint32_t INVALID_DISTINCT = -1;
@@ -63,6 +128,8 @@ static constexpr const char *SYSTEM_DATABASE_NAME = "system";
 static constexpr const char *TABLE_META_NAME = "huadb_table";
 static constexpr const char *DATABASE_META_NAME = "huadb_database";
 static constexpr const char *STATISTIC_META_NAME = "huadb_statistic";
+static constexpr const char *STAT_BUFFER_VIEW_NAME = "huadb_stat_buffer";
+static constexpr const char *STAT_IO_VIEW_NAME = "huadb_stat_io";
 
 static constexpr const char *DEFAULT_DATABASE_NAME = "huadb";
 
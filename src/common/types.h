@@ -14,6 +14,9 @@ using slotid_t = uint16_t;
 using db_size_t = uint16_t;
 using enum_t = uint8_t;
 
+// 表的存储格式：按行存储的槽页，按列划分的 PAX 页面，或页面写满时按列压缩的 PAX 页面
+enum class StorageType : enum_t { ROW, COLUMNAR, COMPRESSED_COLUMNAR };
+
 struct Rid {
   pageid_t page_id_;
   slotid_t slot_id_;
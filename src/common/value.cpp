@@ -3,6 +3,7 @@
 #include <cstring>
 #include <sstream>
 
+#include "common/constants.h"
 #include "common/exceptions.h"
 
 namespace huadb {
@@ -31,8 +32,42 @@ Value::Value(std::string val, Type type) : type_(type) {
 
 Value::Value(std::vector<Value> values) : values_(std::move(values)), type_(Type::LIST) {}
 
+Value Value::External(Type type, std::string pointer, std::shared_ptr<const ExternalReader> reader,
+                      const std::string *value) {
+  Value result(type, EXTERNAL_POINTER_SIZE);
+  result.is_null_ = false;
+  result.external_ = std::make_shared<ExternalString>();
+  result.external_->pointer_ = std::move(pointer);
+  result.external_->reader_ = std::move(reader);
+  if (value != nullptr) {
+    std::call_once(result.external_->loaded_, [&]() { result.external_->value_ = *value; });
+  }
+  return result;
+}
+
 bool Value::IsNull() const { return is_null_ || type_ == Type::NULL_TYPE; }
 
+bool Value::IsExternal() const { return external_ != nullptr; }
+
+const std::string &Value::GetExternalPointer() const { return external_->pointer_; }
+
+const std::shared_ptr<const ExternalReader> &Value::GetExternalReader() const { return external_->reader_; }
+
+void Value::SetExternalReader(std::shared_ptr<const ExternalReader> reader) { external_->reader_ = std::move(reader); }
+
+const std::string &Value::GetString() const {
+  if (external_ == nullptr) {
+    return str_;
+  }
+  std::call_once(external_->loaded_, [this]() {
+    if (external_->reader_ == nullptr) {
+      throw DbException("No reader for external value");
+    }
+    external_->value_ = external_->reader_->Read(external_->pointer_);
+  });
+  return external_->value_;
+}
+
 db_size_t Value::GetSize() const { return size_; }
 
 std::string Value::ToString() const {
@@ -57,7 +92,7 @@ std::string Value::ToString() const {
     }
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_;
+      return GetString();
     default:
       throw DbException("Unknown value type in ToString");
   }
@@ -80,6 +115,12 @@ db_size_t Value::SerializeTo(char *data) const {
       break;
     case Type::VARCHAR:
     case Type::CHAR: {
+      if (external_ != nullptr) {
+        memcpy(data, &EXTERNAL_VALUE_FLAG, 2);
+        memcpy(data + 2, external_->pointer_.data(), EXTERNAL_POINTER_SIZE);
+        result = EXTERNAL_POINTER_SIZE + 2;
+        break;
+      }
       db_size_t str_size = str_.size();
       memcpy(data, &str_size, 2);
       memcpy(data + 2, str_.c_str(), size_);
@@ -111,6 +152,14 @@ db_size_t Value::DeserializeFrom(const char *data) {
     case Type::VARCHAR:
     case Type::CHAR: {
       memcpy(&size_, data, 2);
+      if ((size_ & EXTERNAL_VALUE_FLAG) != 0) {
+        // 溢出指针，读取器由调用者设置
+        size_ = EXTERNAL_POINTER_SIZE;
+        external_ = std::make_shared<ExternalString>();
+        external_->pointer_ = std::string(data + 2, data + size_ + 2);
+        result = size_ + 2;
+        break;
+      }
       str_ = std::string(data + 2, data + size_ + 2);
       result = size_ + 2;
       break;
@@ -162,7 +211,7 @@ std::string Value::GetValue<std::string>() const {
   if (!TypeUtil::IsString(type_)) {
     throw DbException("Type mismatch (expected char/varchar)");
   }
-  return str_;
+  return GetString();
 }
 
 template <>
@@ -170,7 +219,7 @@ const char *Value::GetValue<const char *>() const {
   if (!TypeUtil::IsString(type_)) {
     throw DbException("Type mismatch (expected char/varchar)");
   }
-  return str_.c_str();
+  return GetString().c_str();
 }
 
 bool Value::Less(const Value &other) const {
@@ -184,7 +233,7 @@ bool Value::Less(const Value &other) const {
       return val_.double_ < other.val_.double_;
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_ < other.str_;
+      return GetString() < other.GetString();
     default:
       throw DbException("Type unsupported for Less operation");
   }
@@ -203,7 +252,7 @@ bool Value::Equal(const Value &other) const {
       return val_.double_ == other.val_.double_;
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_ == other.str_;
+      return GetString() == other.GetString();
     default:
       throw DbException("Type unsupported for Equal operation");
   }
@@ -220,7 +269,7 @@ bool Value::Greater(const Value &other) const {
       return val_.double_ > other.val_.double_;
     case Type::CHAR:
     case Type::VARCHAR:
-      return str_ > other.str_;
+      return GetString() > other.GetString();
     default:
       throw DbException("Type unsupported for Greater operation");
   }
@@ -283,12 +332,13 @@ Value Value::CastAsBool() const {
       return Value(val_.bool_);
     case Type::CHAR:
     case Type::VARCHAR: {
-      if (str_ == "t") {
+      const auto &str = GetString();
+      if (str == "t") {
         return Value(true);
-      } else if (str_ == "f") {
+      } else if (str == "f") {
         return Value(false);
       } else {
-        throw DbException("Unknown str in CastAsBool: " + str_);
+        throw DbException("Unknown str in CastAsBool: " + str);
       }
     }
     default:
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -9,6 +11,14 @@
 
 namespace huadb {
 
+// 行外存储值的读取接口，由表的溢出存储实现
+class ExternalReader {
+ public:
+  virtual ~ExternalReader() = default;
+  // 根据溢出指针读取值
+  virtual std::string Read(const std::string &pointer) const = 0;
+};
+
 class Value {
  public:
   Value();
@@ -20,7 +30,17 @@ class Value {
   explicit Value(const char *val, Type type = Type::VARCHAR);
   explicit Value(std::string val, Type type = Type::VARCHAR);
   explicit Value(std::vector<Value> values);
+  // 行外存储的字符串值，记录中只保存溢出指针，首次访问值时才通过 reader 读取
+  // 已知值的内容时（如刚写入溢出存储）可通过 value 给出，避免再次读取
+  static Value External(Type type, std::string pointer, std::shared_ptr<const ExternalReader> reader,
+                        const std::string *value = nullptr);
   bool IsNull() const;
+  // 是否为行外存储的值，此时 GetSize 和 SerializeTo 对应的是溢出指针
+  bool IsExternal() const;
+  const std::string &GetExternalPointer() const;
+  const std::shared_ptr<const ExternalReader> &GetExternalReader() const;
+  // 反序列化得到的行外存储值需设置读取器后才能访问
+  void SetExternalReader(std::shared_ptr<const ExternalReader> reader);
   db_size_t GetSize() const;
   std::string ToString() const;
   db_size_t SerializeTo(char *data) const;
@@ -48,6 +68,17 @@ class Value {
   bool operator==(const Value &other) const;
 
  private:
+  // 行外存储的值，多个 Value 副本共享，值在首次访问时读取一次
+  struct ExternalString {
+    std::string pointer_;
+    std::shared_ptr<const ExternalReader> reader_;
+    std::once_flag loaded_;
+    std::string value_;
+  };
+
+  // 字符串的内容，行外存储的值在此时读取
+  const std::string &GetString() const;
+
   Type type_;
   bool is_null_ = false;
   union {
@@ -60,6 +91,7 @@ class Value {
   std::string str_;
   std::vector<Value> values_;
   db_size_t size_;
+  std::shared_ptr<ExternalString> external_;
 };
 
 }  // namespace huadb
@@ -1,6 +1,10 @@
 #include "database/database_engine.h"
 
+#include <cctype>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
 
 #include "binder/binder.h"
 #include "binder/statements/statements.h"
@@ -17,10 +21,11 @@
 
 namespace huadb {
 
-DatabaseEngine::DatabaseEngine() {
+DatabaseEngine::DatabaseEngine(size_t buffer_pool_size, IOEngineType io_engine_type, bool direct_io,
+                               size_t page_size) {
   // 数据库是否正常关闭
   bool normal_shutdown = true;
-  disk_ = std::make_unique<Disk>();
+  disk_ = std::make_unique<Disk>(io_engine_type, direct_io);
   lock_manager_ = std::make_unique<LockManager>();
   oid_t oid = PRESERVED_OID;
   // 如存在控制文件，读取文件内容
@@ -28,20 +33,26 @@ DatabaseEngine::DatabaseEngine() {
     std::ifstream in(CONTROL_NAME);
     xid_t xid;
     lsn_t lsn;
-    // 下一个事务id，lsn，oid，以及是否正常关闭
+    // 下一个事务id，lsn，oid，是否正常关闭，以及页面大小
     in >> xid >> lsn >> oid >> normal_shutdown;
+    // 不记录页面大小的旧控制文件使用默认页面大小
+    if (!(in >> page_size)) {
+      page_size = DEFAULT_PAGE_SIZE;
+    }
+    disk_->SetPageSize(page_size);
     std::ofstream out(CONTROL_NAME);
     out.flush();
-    out << xid << " " << lsn << " " << oid << " " << false << std::endl;
+    out << xid << " " << lsn << " " << oid << " " << false << " " << page_size << std::endl;
     transaction_manager_ = std::make_unique<TransactionManager>(*lock_manager_, xid);
     log_manager_ = std::make_unique<LogManager>(*disk_, *transaction_manager_, lsn);
   } else {
+    disk_->SetPageSize(page_size);
     std::ofstream out(CONTROL_NAME);
-    out << FIRST_XID << " " << FIRST_LSN << " " << PRESERVED_OID << " " << false;
+    out << FIRST_XID << " " << FIRST_LSN << " " << PRESERVED_OID << " " << false << " " << page_size;
     transaction_manager_ = std::make_unique<TransactionManager>(*lock_manager_, FIRST_XID);
     log_manager_ = std::make_unique<LogManager>(*disk_, *transaction_manager_, FIRST_LSN);
   }
-  buffer_pool_ = std::make_shared<BufferPool>(*disk_, *log_manager_);
+  buffer_pool_ = std::make_shared<BufferPool>(*disk_, *log_manager_, buffer_pool_size);
   log_manager_->SetBufferPool(buffer_pool_);
 
   catalog_ = std::make_unique<Catalog>(*buffer_pool_, *log_manager_, oid);
@@ -59,13 +70,21 @@ DatabaseEngine::DatabaseEngine() {
   if (!normal_shutdown) {
     Recover();
   }
+  LoadWarmupFile();
 }
 
 DatabaseEngine::~DatabaseEngine() {
+  // 先停止后台写线程、预读线程和预热线程，避免其访问已析构的日志管理器和磁盘
+  buffer_pool_->SetBackgroundWriterTarget(0);
+  buffer_pool_->SetReadAheadPages(0);
+  buffer_pool_->StopPrewarm();
   // 如果数据库不是崩溃状态，关闭数据库
   if (std::uncaught_exceptions() == 0 && !crashed_) {
     CloseDatabase();
   }
+  // 表析构时将空闲空间映射写入数据目录，需在磁盘析构（离开数据目录）前析构 catalog
+  log_manager_->SetCatalog(nullptr);
+  catalog_.reset();
 }
 
 const std::string &DatabaseEngine::GetCurrentDatabase() const { return current_db_; }
@@ -105,6 +124,24 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
     return;
   }
 
+  // PREWARM table_name 不是 PostgreSQL 语法，在解析前处理
+  auto start = sql.find_first_not_of(" \t\n");
+  if (start != std::string::npos && StringUtil::Lower(sql.substr(start, 7)) == "prewarm" &&
+      start + 7 < sql.size() && std::isspace(sql[start + 7])) {
+    auto table_name = sql.substr(start + 7);
+    StringUtil::RTrim(table_name);
+    if (!table_name.empty() && table_name.back() == ';') {
+      table_name.pop_back();
+      StringUtil::RTrim(table_name);
+    }
+    table_name.erase(0, table_name.find_first_not_of(" \t\n"));
+    if (table_name.empty()) {
+      throw DbException("No table name");
+    }
+    Prewarm(StringUtil::Lower(table_name), writer);
+    return;
+  }
+
   // 使用 PostgresParser 解析 SQL
   duckdb::PostgresParser parser;
   parser.Parse(sql);
@@ -149,6 +186,10 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
       continue;
     }
 
+    if (read_only_set_.find(&connection) != read_only_set_.end() && IsWriteStatement(statement->type_)) {
+      throw DbException("Cannot execute write statement in a read-only session");
+    }
+
     bool is_modification_sql = false;
     // 如果该语句不在事务块内，则自动开启一个事务
     if (!InTransaction(connection)) {
@@ -171,7 +212,8 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
             throw DbException("Cannot execute DDL statement within a transaction block");
           }
           const auto &create_table_statement = dynamic_cast<CreateTableStatement &>(*statement);
-          CreateTable(create_table_statement.table_, ColumnList(create_table_statement.columns_), writer);
+          CreateTable(create_table_statement.table_, ColumnList(create_table_statement.columns_),
+                      create_table_statement.storage_type_, writer);
           break;
         }
         case StatementType::CREATE_INDEX_STATEMENT: {
@@ -233,6 +275,9 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
           break;
         }
         case StatementType::VACUUM_STATEMENT: {
+          if (CheckInTransaction(connection)) {
+            throw DbException("Cannot execute VACUUM within a transaction block");
+          }
           const auto &vacuum_statement = dynamic_cast<VacuumStatement &>(*statement);
           Vacuum(vacuum_statement, writer);
           break;
@@ -267,9 +312,10 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
             if (isolation_levels_.find(&connection) != isolation_levels_.end()) {
               isolation_level = isolation_levels_[&connection];
             }
+            bool read_only = read_only_set_.find(&connection) != read_only_set_.end();
             auto executor_context = std::make_unique<ExecutorContext>(
                 *buffer_pool_, *catalog_, *transaction_manager_, *lock_manager_, xids_[&connection], isolation_level,
-                transaction_manager_->GetCidAndIncrement(xids_[&connection]), is_modification_sql);
+                transaction_manager_->GetCidAndIncrement(xids_[&connection]), is_modification_sql, read_only);
 
             // 根据查询上下文和查询计划，生成执行器
             auto executor = ExecutorFactory::CreateExecutor(*executor_context, plan);
@@ -372,17 +418,20 @@ void DatabaseEngine::DropDatabase(const std::string &db_name, bool missing_ok, R
 }
 
 void DatabaseEngine::CloseDatabase() {
+  // Flush 会清空缓存，需在其之前保存页面列表
+  SaveWarmupFile();
   buffer_pool_->Flush();
   log_manager_->Flush();
   log_manager_->Checkpoint();
 
   std::ofstream control(CONTROL_NAME);
   control << transaction_manager_->GetNextXid() << " " << log_manager_->GetNextLSN() << " " << catalog_->GetNextOid()
-          << " " << true;
+          << " " << true << " " << disk_->GetPageSize();
 }
 
-void DatabaseEngine::CreateTable(const std::string &table_name, const ColumnList &column_list, ResultWriter &writer) {
-  catalog_->CreateTable(table_name, column_list);
+void DatabaseEngine::CreateTable(const std::string &table_name, const ColumnList &column_list,
+                                 StorageType storage_type, ResultWriter &writer) {
+  catalog_->CreateTable(table_name, column_list, INVALID_OID, INVALID_OID, true, storage_type);
   WriteOneCell("CREATE TABLE", writer);
 }
 
@@ -470,10 +519,46 @@ void DatabaseEngine::Rollback(const Connection &connection) {
   }
 }
 
-void DatabaseEngine::Checkpoint() { log_manager_->Checkpoint(); }
+void DatabaseEngine::Checkpoint() {
+  log_manager_->Checkpoint();
+  SaveWarmupFile();
+}
 
 void DatabaseEngine::Recover() { log_manager_->Recover(); }
 
+void DatabaseEngine::SaveWarmupFile() const {
+  // 先写入临时文件再重命名，避免写入中途崩溃留下不完整的文件
+  auto temp_name = std::string(WARMUP_NAME) + ".tmp";
+  {
+    std::ofstream out(temp_name);
+    for (const auto &page : buffer_pool_->GetResidentPages()) {
+      out << page.db_oid_ << " " << page.table_oid_ << " " << page.page_id_ << "\n";
+    }
+  }
+  std::filesystem::rename(temp_name, WARMUP_NAME);
+}
+
+void DatabaseEngine::LoadWarmupFile() {
+  if (!disk_->FileExists(WARMUP_NAME)) {
+    return;
+  }
+  std::ifstream in(WARMUP_NAME);
+  std::vector<ResidentPage> pages;
+  ResidentPage page;
+  while (in >> page.db_oid_ >> page.table_oid_ >> page.page_id_) {
+    pages.push_back(page);
+  }
+  if (!pages.empty()) {
+    buffer_pool_->StartPrewarm(std::move(pages));
+  }
+}
+
+void DatabaseEngine::Prewarm(const std::string &table_name, ResultWriter &writer) {
+  auto table = catalog_->GetTable(catalog_->GetTableOid(table_name));
+  auto prewarmed = buffer_pool_->PrewarmTable(table->GetDbOid(), table->GetOid());
+  WriteOneCell(std::to_string(prewarmed), writer);
+}
+
 void DatabaseEngine::Lock(xid_t xid, const LockStatement &stmt, ResultWriter &writer) {
   LockType lock_type;
   if (stmt.lock_type_ == TableLockType::SHARE) {
@@ -529,6 +614,24 @@ void DatabaseEngine::VariableSet(const Connection &connection, const VariableSet
     enable_projection_pushdown_ = String2Bool(stmt.value_);
   } else if (stmt.variable_ == "deadlock") {
     lock_manager_->SetDeadLockType(String2DeadlockType(stmt.value_));
+  } else if (stmt.variable_ == "buffer_pool_size") {
+    buffer_pool_->Resize(String2Size(stmt.value_));
+  } else if (stmt.variable_ == "catalog_buffer_size") {
+    buffer_pool_->ResizeCatalog(String2Size(stmt.value_));
+  } else if (stmt.variable_ == "buffer_strategy") {
+    buffer_pool_->SetBufferStrategy(String2BufferStrategyType(stmt.value_));
+  } else if (stmt.variable_ == "bgwriter_clean_percent") {
+    buffer_pool_->SetBackgroundWriterTarget(String2Size(stmt.value_));
+  } else if (stmt.variable_ == "read_ahead_pages") {
+    buffer_pool_->SetReadAheadPages(String2Size(stmt.value_));
+  } else if (stmt.variable_ == "page_size") {
+    throw DbException("page_size can only be set when creating the data directory");
+  } else if (stmt.variable_ == "read_only") {
+    if (String2Bool(stmt.value_)) {
+      read_only_set_.insert(&connection);
+    } else {
+      read_only_set_.erase(&connection);
+    }
   }
   client_variables_[&connection][stmt.variable_] = stmt.value_;
   WriteOneCell("SET", writer);
@@ -545,8 +648,94 @@ void DatabaseEngine::VariableShow(const Connection &connection, const VariableSh
     return;
   } else if (stmt.variable_ == "disk_access_count") {
     result = std::to_string(disk_->GetAccessCount());
+  } else if (stmt.variable_ == "file_extend_count") {
+    result = std::to_string(disk_->GetExtendCount());
+  } else if (stmt.variable_ == "buffer_hit_count" || stmt.variable_ == "buffer_miss_count" ||
+             stmt.variable_ == "buffer_eviction_count" || stmt.variable_ == "dirty_write_count" ||
+             stmt.variable_ == "read_bytes" || stmt.variable_ == "write_bytes") {
+    TableStatistics total;
+    for (const auto &[table_oid, statistics] : buffer_pool_->GetTableStatistics()) {
+      total += statistics;
+    }
+    if (stmt.variable_ == "buffer_hit_count") {
+      result = std::to_string(total.hits_);
+    } else if (stmt.variable_ == "buffer_miss_count") {
+      result = std::to_string(total.misses_);
+    } else if (stmt.variable_ == "buffer_eviction_count") {
+      result = std::to_string(total.evictions_);
+    } else if (stmt.variable_ == "dirty_write_count") {
+      result = std::to_string(total.dirty_writes_);
+    } else if (stmt.variable_ == "read_bytes") {
+      result = std::to_string(total.read_bytes_);
+    } else {
+      result = std::to_string(total.write_bytes_);
+    }
   } else if (stmt.variable_ == "redo_count") {
     result = std::to_string(log_manager_->GetRedoCount());
+  } else if (stmt.variable_ == "buffer_pool_size") {
+    result = std::to_string(buffer_pool_->GetSize());
+  } else if (stmt.variable_ == "catalog_buffer_size") {
+    result = std::to_string(buffer_pool_->GetCatalogSize());
+  } else if (stmt.variable_ == "buffer_strategy") {
+    result = BufferStrategyType2String(buffer_pool_->GetBufferStrategy());
+  } else if (stmt.variable_ == "bgwriter_clean_percent") {
+    result = std::to_string(buffer_pool_->GetBackgroundWriterTarget());
+  } else if (stmt.variable_ == "foreground_write_count") {
+    result = std::to_string(buffer_pool_->GetForegroundWriteCount());
+  } else if (stmt.variable_ == "background_write_count") {
+    result = std::to_string(buffer_pool_->GetBackgroundWriteCount());
+  } else if (stmt.variable_ == "read_ahead_pages") {
+    result = std::to_string(buffer_pool_->GetReadAheadPages());
+  } else if (stmt.variable_ == "read_ahead_count") {
+    result = std::to_string(buffer_pool_->GetReadAheadCount());
+  } else if (stmt.variable_ == "prewarm_count") {
+    result = std::to_string(buffer_pool_->GetPrewarmCount());
+  } else if (stmt.variable_ == "vacuum_removed_count") {
+    result = std::to_string(vacuum_removed_count_);
+  } else if (stmt.variable_ == "vacuum_truncated_count") {
+    result = std::to_string(vacuum_truncated_count_);
+  } else if (stmt.variable_ == "vacuum_all_visible_count") {
+    result = std::to_string(vacuum_all_visible_count_);
+  } else if (stmt.variable_ == "hot_update_count") {
+    size_t count = 0;
+    for (const auto &table_name : catalog_->GetTableNames()) {
+      count += catalog_->GetTable(catalog_->GetTableOid(table_name))->GetHotUpdateCount();
+    }
+    result = std::to_string(count);
+  } else if (stmt.variable_ == "zone_map_skipped_pages") {
+    size_t count = 0;
+    for (const auto &table_name : catalog_->GetTableNames()) {
+      count += catalog_->GetTable(catalog_->GetTableOid(table_name))->GetZoneMapSkipCount();
+    }
+    result = std::to_string(count);
+  } else if (stmt.variable_ == "compressed_page_count") {
+    size_t count = 0;
+    for (const auto &table_name : catalog_->GetTableNames()) {
+      count += catalog_->GetTable(catalog_->GetTableOid(table_name))->GetCompressedPageCount();
+    }
+    result = std::to_string(count);
+  } else if (stmt.variable_ == "overflow_write_count" || stmt.variable_ == "overflow_compressed_count" ||
+             stmt.variable_ == "overflow_read_count") {
+    size_t count = 0;
+    for (const auto &table_name : catalog_->GetTableNames()) {
+      const auto &overflow = catalog_->GetTable(catalog_->GetTableOid(table_name))->GetOverflowStorage();
+      if (stmt.variable_ == "overflow_write_count") {
+        count += overflow.GetWriteCount();
+      } else if (stmt.variable_ == "overflow_compressed_count") {
+        count += overflow.GetCompressedCount();
+      } else {
+        count += overflow.GetReadCount();
+      }
+    }
+    result = std::to_string(count);
+  } else if (stmt.variable_ == "ring_reuse_count") {
+    result = std::to_string(buffer_pool_->GetRingReuseCount());
+  } else if (stmt.variable_ == "io_engine") {
+    result = IOEngineType2String(disk_->GetIOEngineType());
+  } else if (stmt.variable_ == "direct_io") {
+    result = disk_->IsDirectIO() ? "on" : "off";
+  } else if (stmt.variable_ == "page_size") {
+    result = std::to_string(disk_->GetPageSize());
   } else {
     if (client_variables_.find(&connection) == client_variables_.end() ||
         client_variables_.at(&connection).find(stmt.variable_) == client_variables_.at(&connection).end()) {
@@ -616,7 +805,25 @@ void DatabaseEngine::Analyze(const AnalyzeStatement &stmt, ResultWriter &writer)
 }
 
 void DatabaseEngine::Vacuum(const VacuumStatement &stmt, ResultWriter &writer) {
-  // LAB 1 ADVANCED BEGIN
+  std::vector<std::string> table_names;
+  if (stmt.table_ == nullptr) {
+    table_names = catalog_->GetTableNames();
+  } else {
+    table_names.push_back(stmt.table_->table_);
+  }
+  // 删除事务的 xid 小于 oldest_xmin 的记录对所有活跃事务及之后开始的事务都不可见
+  auto oldest_xmin = transaction_manager_->GetOldestXmin();
+  for (const auto &table_name : table_names) {
+    auto table = catalog_->GetTable(catalog_->GetTableOid(table_name));
+    // 系统表原地更新，没有旧版本需要回收
+    if (table->GetDbOid() == SYSTEM_DATABASE_OID) {
+      continue;
+    }
+    auto result = table->Vacuum(oldest_xmin);
+    vacuum_removed_count_ += result.removed_count_;
+    vacuum_truncated_count_ += result.truncated_count_;
+    vacuum_all_visible_count_ += result.all_visible_count_;
+  }
   WriteOneCell("Vacuum", writer);
 }
 
@@ -676,6 +883,46 @@ DeadlockType DatabaseEngine::String2DeadlockType(const std::string &str) {
   }
 }
 
+BufferStrategyType DatabaseEngine::String2BufferStrategyType(const std::string &str) {
+  if (str == "lru") {
+    return BufferStrategyType::LRU;
+  } else if (str == "clock") {
+    return BufferStrategyType::CLOCK;
+  } else if (str == "lru_k") {
+    return BufferStrategyType::LRU_K;
+  } else if (str == "two_queue") {
+    return BufferStrategyType::TWO_QUEUE;
+  } else {
+    throw DbException("Unknown buffer strategy " + str);
+  }
+}
+
+std::string DatabaseEngine::BufferStrategyType2String(BufferStrategyType type) {
+  switch (type) {
+    case BufferStrategyType::LRU:
+      return "lru";
+    case BufferStrategyType::CLOCK:
+      return "clock";
+    case BufferStrategyType::LRU_K:
+      return "lru_k";
+    case BufferStrategyType::TWO_QUEUE:
+      return "two_queue";
+    default:
+      throw DbException("Unknown buffer strategy type");
+  }
+}
+
+std::string DatabaseEngine::IOEngineType2String(IOEngineType type) {
+  switch (type) {
+    case IOEngineType::SYNC:
+      return "sync";
+    case IOEngineType::IO_URING:
+      return "io_uring";
+    default:
+      throw DbException("Unknown I/O engine type");
+  }
+}
+
 bool DatabaseEngine::String2Bool(const std::string &str) {
   if (str == "true" || str == "1" || str == "on") {
     return true;
@@ -685,4 +932,34 @@ bool DatabaseEngine::String2Bool(const std::string &str) {
   throw DbException("Unknown boolean value " + str);
 }
 
+bool DatabaseEngine::IsWriteStatement(StatementType type) {
+  switch (type) {
+    case StatementType::ANALYZE_STATEMENT:
+    case StatementType::CREATE_DATABASE_STATEMENT:
+    case StatementType::CREATE_INDEX_STATEMENT:
+    case StatementType::CREATE_TABLE_STATEMENT:
+    case StatementType::DELETE_STATEMENT:
+    case StatementType::DROP_DATABASE_STATEMENT:
+    case StatementType::DROP_INDEX_STATEMENT:
+    case StatementType::DROP_TABLE_STATEMENT:
+    case StatementType::INSERT_STATEMENT:
+    case StatementType::UPDATE_STATEMENT:
+    case StatementType::VACUUM_STATEMENT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+size_t DatabaseEngine::String2Size(const std::string &str) {
+  if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos) {
+    throw DbException("Invalid size value " + str);
+  }
+  try {
+    return std::stoull(str);
+  } catch (std::out_of_range &) {
+    throw DbException("Invalid size value " + str);
+  }
+}
+
 }  // namespace huadb
@@ -5,8 +5,10 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "binder/statement.h"
 #include "catalog/catalog.h"
 #include "catalog/column_definition.h"
+#include "common/constants.h"
 #include "common/types.h"
 #include "log/log_manager.h"
 #include "optimizer/optimizer.h"
@@ -29,7 +31,10 @@ class VacuumStatement;
 
 class DatabaseEngine {
  public:
-  DatabaseEngine();
+  // page_size 只在创建数据目录时生效，已有数据目录使用控制文件中记录的页面大小
+  explicit DatabaseEngine(size_t buffer_pool_size = DEFAULT_BUFFER_SIZE,
+                          IOEngineType io_engine_type = IOEngineType::SYNC, bool direct_io = false,
+                          size_t page_size = DEFAULT_PAGE_SIZE);
   ~DatabaseEngine();
 
   const std::string &GetCurrentDatabase() const;
@@ -53,7 +58,8 @@ class DatabaseEngine {
   void DropDatabase(const std::string &db_name, bool missing_ok, ResultWriter &writer);
   void CloseDatabase();
 
-  void CreateTable(const std::string &table_name, const ColumnList &column_list, ResultWriter &writer);
+  void CreateTable(const std::string &table_name, const ColumnList &column_list, StorageType storage_type,
+                   ResultWriter &writer);
   void DescribeTable(const std::string &table_name, ResultWriter &writer) const;
   void ShowTables(ResultWriter &writer) const;
   void DropTable(const std::string &table_name, ResultWriter &writer);
@@ -68,6 +74,13 @@ class DatabaseEngine {
   void Checkpoint();
   void Recover();
 
+  // 将缓存中的页面列表写入 warmup 文件，启动时据此预热缓存
+  void SaveWarmupFile() const;
+  // 读取 warmup 文件并在后台预热缓存
+  void LoadWarmupFile();
+  // 将表的页面读入缓存
+  void Prewarm(const std::string &table_name, ResultWriter &writer);
+
   void Explain(const ExplainStatement &stmt, ResultWriter &writer);
   void Lock(xid_t xid, const LockStatement &stmt, ResultWriter &writer);
 
@@ -84,6 +97,12 @@ class DatabaseEngine {
   static JoinOrderAlgorithm String2JoinOrderAlgorithm(const std::string &str);
   static DeadlockType String2DeadlockType(const std::string &str);
   static bool String2Bool(const std::string &str);
+  static size_t String2Size(const std::string &str);
+  static BufferStrategyType String2BufferStrategyType(const std::string &str);
+  static std::string BufferStrategyType2String(BufferStrategyType type);
+  static std::string IOEngineType2String(IOEngineType type);
+  // 语句是否修改表数据、表结构或统计信息，只读会话中不允许执行
+  static bool IsWriteStatement(StatementType type);
 
   std::string current_db_;
 
@@ -98,12 +117,19 @@ class DatabaseEngine {
   std::unordered_map<const Connection *, xid_t> xids_;
   std::unordered_map<const Connection *, IsolationLevel> isolation_levels_;
   std::unordered_set<const Connection *> auto_transaction_set_;
+  // 只读会话，顺序扫描可直接从映射到内存的表文件读取页面
+  std::unordered_set<const Connection *> read_only_set_;
 
   ForceJoin force_join_ = ForceJoin::NONE;
   JoinOrderAlgorithm join_order_algorithm_ = DEFAULT_JOIN_ORDER_ALGORITHM;
   bool enable_optimizer_ = true;
   bool enable_projection_pushdown_ = false;
 
+  // VACUUM 回收的记录数目、截断的页面数目和标记为全可见的页面数目
+  size_t vacuum_removed_count_ = 0;
+  size_t vacuum_truncated_count_ = 0;
+  size_t vacuum_all_visible_count_ = 0;
+
   bool crashed_ = false;
 };
 
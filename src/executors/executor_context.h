@@ -10,7 +10,7 @@ class ExecutorContext {
  public:
   ExecutorContext(BufferPool &buffer_pool, Catalog &catalog, TransactionManager &transaction_manager,
                   LockManager &lock_manager, xid_t xid, IsolationLevel isolation_level, cid_t cid,
-                  bool is_modification_sql)
+                  bool is_modification_sql, bool read_only = false)
       : buffer_pool_(buffer_pool),
         catalog_(catalog),
         transaction_manager_(transaction_manager),
@@ -18,7 +18,8 @@ class ExecutorContext {
         xid_(xid),
         isolation_level_(isolation_level),
         cid_(cid),
-        is_modification_sql_(is_modification_sql) {}
+        is_modification_sql_(is_modification_sql),
+        read_only_(read_only) {}
 
   BufferPool &GetBufferPool() const { return buffer_pool_; }
   Catalog &GetCatalog() const { return catalog_; }
@@ -28,6 +29,7 @@ class ExecutorContext {
   IsolationLevel GetIsolationLevel() const { return isolation_level_; }
   cid_t GetCid() const { return cid_; }
   bool IsModificationSql() const { return is_modification_sql_; }
+  bool IsReadOnly() const { return read_only_; }
 
  private:
   BufferPool &buffer_pool_;
@@ -38,6 +40,7 @@ class ExecutorContext {
   IsolationLevel isolation_level_;
   cid_t cid_;
   bool is_modification_sql_;
+  bool read_only_;  // 查询是否来自只读会话
 };
 
 }  // namespace huadb
@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "catalog/system_view.h"
 #include "executors/aggregate_executor.h"
 #include "executors/delete_executor.h"
 #include "executors/executor.h"
@@ -17,6 +18,7 @@
 #include "executors/orderby_executor.h"
 #include "executors/projection_executor.h"
 #include "executors/seqscan_executor.h"
+#include "executors/system_view_executor.h"
 #include "executors/update_executor.h"
 #include "executors/values_executor.h"
 
@@ -28,6 +30,9 @@ class ExecutorFactory {
     switch (plan->GetType()) {
       case OperatorType::SEQSCAN: {
         auto seqscan_operator = std::dynamic_pointer_cast<const SeqScanOperator>(plan);
+        if (SystemView::IsSystemView(seqscan_operator->GetTableOid())) {
+          return std::make_unique<SystemViewExecutor>(context, std::move(seqscan_operator));
+        }
         return std::make_unique<SeqScanExecutor>(context, std::move(seqscan_operator));
       }
       case OperatorType::INSERT: {
@@ -47,6 +52,9 @@ class ExecutorFactory {
       }
       case OperatorType::PROJECTION: {
         auto projection_operator = std::dynamic_pointer_cast<const ProjectionOperator>(plan);
+        if (auto scan = CreateViewScan(context, plan->GetChildren()[0], projection_operator)) {
+          return scan;
+        }
         auto child = CreateExecutor(context, plan->GetChildren()[0]);
         return std::make_unique<ProjectionExecutor>(context, std::move(projection_operator), std::move(child));
       }
@@ -76,6 +84,9 @@ class ExecutorFactory {
                                                   std::move(right));
       }
       case OperatorType::FILTER: {
+        if (auto scan = CreateViewScan(context, plan, nullptr)) {
+          return scan;
+        }
         auto filter_operator = std::dynamic_pointer_cast<const FilterOperator>(plan);
         auto child = CreateExecutor(context, plan->GetChildren()[0]);
         return std::make_unique<FilterExecutor>(context, std::move(filter_operator), std::move(child));
@@ -104,6 +115,29 @@ class ExecutorFactory {
         throw DbException("Unknown operator type");
     }
   }
+
+ private:
+  // plan 为行存表上的 SeqScan 或其上的 Filter 时，将其与 projection 合并为一个扫描执行器，否则返回空指针
+  // 合并后过滤条件和投影在页面中的记录视图上求值，不满足条件的记录不构造 Record，投影时只构造用到的列的值
+  static std::unique_ptr<Executor> CreateViewScan(ExecutorContext &context, std::shared_ptr<const Operator> plan,
+                                                  std::shared_ptr<const ProjectionOperator> projection) {
+    std::shared_ptr<const FilterOperator> filter_operator;
+    if (plan->GetType() == OperatorType::FILTER) {
+      filter_operator = std::dynamic_pointer_cast<const FilterOperator>(plan);
+      plan = plan->GetChildren()[0];
+    }
+    if (plan->GetType() != OperatorType::SEQSCAN) {
+      return nullptr;
+    }
+    auto seqscan_operator = std::dynamic_pointer_cast<const SeqScanOperator>(plan);
+    auto table_oid = seqscan_operator->GetTableOid();
+    if (SystemView::IsSystemView(table_oid) ||
+        context.GetCatalog().GetTable(table_oid)->GetStorageType() != StorageType::ROW) {
+      return nullptr;
+    }
+    return std::make_unique<SeqScanExecutor>(context, std::move(seqscan_operator), std::move(filter_operator),
+                                             std::move(projection));
+  }
 };
 
 }  // namespace huadb
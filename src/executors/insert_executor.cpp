@@ -10,6 +10,10 @@ void InsertExecutor::Init() {
   children_[0]->Init();
   table_ = context_.GetCatalog().GetTable(plan_->GetTableOid());
   column_list_ = context_.GetCatalog().GetTableColumnList(plan_->GetTableOid());
+  // 插入查询结果时行数未知，使用页帧环，避免大批量插入冲掉缓存中的其他页面；页帧环填满前与普通插入相同
+  if (ScansTable(*plan_->GetChildren()[0])) {
+    ring_ = context_.GetBufferPool().CreateBulkWriteRing();
+  }
 }
 
 std::shared_ptr<Record> InsertExecutor::Next() {
@@ -27,11 +31,23 @@ std::shared_ptr<Record> InsertExecutor::Next() {
     auto table_record = std::make_shared<Record>(std::move(values));
     // 通过 context_ 获取正确的锁，加锁失败时抛出异常
     // LAB 3 BEGIN
-    auto rid = table_->InsertRecord(std::move(table_record), context_.GetXid(), context_.GetCid(), true);
+    auto rid = table_->InsertRecord(std::move(table_record), context_.GetXid(), context_.GetCid(), true, ring_.get());
     count++;
   }
   finished_ = true;
   return std::make_shared<Record>(std::vector{Value(count)});
 }
 
+bool InsertExecutor::ScansTable(const Operator &plan) {
+  if (plan.GetType() == OperatorType::SEQSCAN) {
+    return true;
+  }
+  for (const auto &child : plan.GetChildren()) {
+    if (ScansTable(*child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace huadb
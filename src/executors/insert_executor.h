@@ -13,9 +13,13 @@ class InsertExecutor : public Executor {
   std::shared_ptr<Record> Next() override;
 
  private:
+  // 查询计划是否读取表，即是否为 INSERT ... SELECT
+  static bool ScansTable(const Operator &plan);
+
   std::shared_ptr<const InsertOperator> plan_;
   std::shared_ptr<Table> table_;
   ColumnList column_list_;
+  std::shared_ptr<BufferRing> ring_;  // INSERT ... SELECT 批量插入使用的页帧环
   bool finished_ = false;
 };
 
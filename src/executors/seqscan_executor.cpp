@@ -2,19 +2,49 @@
 
 namespace huadb {
 
-SeqScanExecutor::SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan)
-    : Executor(context, {}), plan_(std::move(plan)) {}
+SeqScanExecutor::SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan,
+                                 std::shared_ptr<const FilterOperator> filter,
+                                 std::shared_ptr<const ProjectionOperator> projection)
+    : Executor(context, {}), plan_(std::move(plan)), filter_(std::move(filter)), projection_(std::move(projection)) {}
 
 void SeqScanExecutor::Init() {
   auto table = context_.GetCatalog().GetTable(plan_->GetTableOid());
-  scan_ = std::make_unique<TableScan>(context_.GetBufferPool(), table, Rid{table->GetFirstPageId(), 0});
+  scan_ = std::make_unique<TableScan>(context_.GetBufferPool(), table, Rid{table->GetFirstPageId(), 0},
+                                      context_.IsReadOnly(), plan_->column_ids_, plan_->ranges_);
+  if (filter_ == nullptr && projection_ == nullptr) {
+    return;
+  }
+  TableScan::ViewPredicate predicate;
+  if (filter_ != nullptr) {
+    predicate = [filter = filter_](const RecordView &view) {
+      auto value = filter->predicate_->EvaluateView(view);
+      return !value.IsNull() && value.GetValue<bool>();
+    };
+  }
+  TableScan::ViewProjector projector;
+  if (projection_ != nullptr) {
+    projector = [projection = projection_](const RecordView &view) {
+      std::vector<Value> values;
+      values.reserve(projection->exprs_.size());
+      for (const auto &expr : projection->exprs_) {
+        values.push_back(expr->EvaluateView(view));
+      }
+      return std::make_shared<Record>(std::move(values), view.GetRid());
+    };
+  }
+  scan_->SetViewCallbacks(std::move(predicate), std::move(projector));
 }
 
 std::shared_ptr<Record> SeqScanExecutor::Next() {
   std::unordered_set<xid_t> active_xids;
   // 根据隔离级别，获取活跃事务的 xid（通过 context_ 获取需要的信息）
   // 通过 context_ 获取正确的锁，加锁失败时抛出异常
-  // LAB 3 BEGIN
+  if (context_.GetIsolationLevel() == IsolationLevel::READ_COMMITTED) {
+    active_xids = context_.GetTransactionManager().GetActiveTransactions();
+  } else {
+    active_xids = context_.GetTransactionManager().GetSnapshot(context_.GetXid());
+  }
+  active_xids.erase(context_.GetXid());
   return scan_->GetNextRecord(context_.GetXid(), context_.GetIsolationLevel(), context_.GetCid(), active_xids);
 }
 
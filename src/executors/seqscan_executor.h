@@ -1,19 +1,26 @@
 #pragma once
 
 #include "executors/executor.h"
+#include "operators/filter_operator.h"
+#include "operators/projection_operator.h"
 #include "operators/seqscan_operator.h"
 
 namespace huadb {
 
 class SeqScanExecutor : public Executor {
  public:
-  SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan);
+  // filter 和 projection 为合并到扫描中的上层算子，非空时在页面中的记录视图上求值，只用于行存表
+  SeqScanExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan,
+                  std::shared_ptr<const FilterOperator> filter = nullptr,
+                  std::shared_ptr<const ProjectionOperator> projection = nullptr);
 
   void Init() override;
   std::shared_ptr<Record> Next() override;
 
  private:
   std::shared_ptr<const SeqScanOperator> plan_;
+  std::shared_ptr<const FilterOperator> filter_;
+  std::shared_ptr<const ProjectionOperator> projection_;
   std::unique_ptr<TableScan> scan_;
 };
 
@@ -0,0 +1,77 @@
+#include "executors/system_view_executor.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#include "storage/disk.h"
+
+namespace huadb {
+
+// 统计值超出 INT 的范围时取 INT 的最大值
+static Value CounterValue(uint64_t counter) {
+  return Value(static_cast<int32_t>(std::min<uint64_t>(counter, std::numeric_limits<int32_t>::max())));
+}
+
+SystemViewExecutor::SystemViewExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan)
+    : Executor(context, {}), plan_(std::move(plan)) {}
+
+void SystemViewExecutor::Init() {
+  records_.clear();
+  cursor_ = 0;
+  if (plan_->GetTableOid() == STAT_BUFFER_VIEW_OID) {
+    GenerateBufferStatistics();
+  } else {
+    GenerateIOStatistics();
+  }
+}
+
+std::shared_ptr<Record> SystemViewExecutor::Next() {
+  if (cursor_ >= records_.size()) {
+    return nullptr;
+  }
+  return records_[cursor_++];
+}
+
+void SystemViewExecutor::GenerateBufferStatistics() {
+  // 只能获取系统表和当前数据库中的表名，其余的表（包括已删除的表）表名为空
+  std::unordered_map<oid_t, std::string> table_names = {{TABLE_META_OID, TABLE_META_NAME},
+                                                        {DATABASE_META_OID, DATABASE_META_NAME},
+                                                        {STATISTIC_META_OID, STATISTIC_META_NAME}};
+  auto &catalog = context_.GetCatalog();
+  for (const auto &table_name : catalog.GetTableNames()) {
+    table_names[catalog.GetTableOid(table_name)] = table_name;
+  }
+  for (const auto &[table_oid, statistics] : context_.GetBufferPool().GetTableStatistics()) {
+    auto iter = table_names.find(table_oid);
+    std::vector<Value> values;
+    values.emplace_back(static_cast<int32_t>(table_oid));
+    values.emplace_back(static_cast<int32_t>(statistics.db_oid_));
+    values.emplace_back(iter == table_names.end() ? "" : iter->second);
+    values.push_back(CounterValue(statistics.hits_));
+    values.push_back(CounterValue(statistics.misses_));
+    values.push_back(CounterValue(statistics.evictions_));
+    values.push_back(CounterValue(statistics.dirty_writes_));
+    values.push_back(CounterValue(statistics.read_bytes_));
+    values.push_back(CounterValue(statistics.write_bytes_));
+    records_.push_back(std::make_shared<Record>(std::move(values)));
+  }
+}
+
+void SystemViewExecutor::GenerateIOStatistics() {
+  const auto &disk = context_.GetBufferPool().GetDisk();
+  std::vector<std::pair<std::string, const LatencyHistogram *>> histograms = {
+      {"read", &disk.GetReadLatency()}, {"write", &disk.GetWriteLatency()}, {"log_write", &disk.GetLogWriteLatency()}};
+  for (const auto &[operation, histogram] : histograms) {
+    auto counts = histogram->GetCounts();
+    for (size_t i = 0; i < counts.size(); i++) {
+      if (counts[i] == 0) {
+        continue;
+      }
+      records_.push_back(std::make_shared<Record>(std::vector<Value>{
+          Value(operation), Value(LatencyHistogram::GetBucketName(i)), CounterValue(counts[i])}));
+    }
+  }
+}
+
+}  // namespace huadb
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+#include "executors/executor.h"
+#include "operators/seqscan_operator.h"
+
+namespace huadb {
+
+// 扫描系统视图，初始化时根据缓存与磁盘的统计信息生成视图的全部记录
+class SystemViewExecutor : public Executor {
+ public:
+  SystemViewExecutor(ExecutorContext &context, std::shared_ptr<const SeqScanOperator> plan);
+
+  void Init() override;
+  std::shared_ptr<Record> Next() override;
+
+ private:
+  // huadb_stat_buffer 的记录，每个表一行
+  void GenerateBufferStatistics();
+  // huadb_stat_io 的记录，每种操作的每个非空延迟区间一行
+  void GenerateIOStatistics();
+
+  std::shared_ptr<const SeqScanOperator> plan_;
+  std::vector<std::shared_ptr<Record>> records_;
+  size_t cursor_ = 0;
+};
+
+}  // namespace huadb
@@ -9,6 +9,7 @@ UpdateExecutor::UpdateExecutor(ExecutorContext &context, std::shared_ptr<const U
 void UpdateExecutor::Init() {
   children_[0]->Init();
   table_ = context_.GetCatalog().GetTable(plan_->GetTableOid());
+  oldest_xmin_ = context_.GetTransactionManager().GetOldestXmin();
 }
 
 std::shared_ptr<Record> UpdateExecutor::Next() {
@@ -24,7 +25,8 @@ std::shared_ptr<Record> UpdateExecutor::Next() {
     auto new_record = std::make_shared<Record>(std::move(values));
     // 通过 context_ 获取正确的锁，加锁失败时抛出异常
     // LAB 3 BEGIN
-    auto rid = table_->UpdateRecord(record->GetRid(), context_.GetXid(), context_.GetCid(), new_record, true);
+    auto rid =
+        table_->UpdateRecord(record->GetRid(), context_.GetXid(), context_.GetCid(), new_record, true, oldest_xmin_);
     count++;
   }
   finished_ = true;
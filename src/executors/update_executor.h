@@ -15,6 +15,7 @@ class UpdateExecutor : public Executor {
  private:
   std::shared_ptr<const UpdateOperator> plan_;
   std::shared_ptr<Table> table_;
+  xid_t oldest_xmin_;  // 页内更新时回收页面中旧版本的依据
   bool finished_ = false;
 };
 
@@ -1,5 +1,7 @@
 #include "log/log_manager.h"
 
+#include <fstream>
+
 #include "common/exceptions.h"
 #include "log/log_records/log_records.h"
 
@@ -22,6 +24,7 @@ void LogManager::Clear() {
 void LogManager::Flush() { Flush(NULL_LSN); }
 
 void LogManager::SetDirty(oid_t oid, pageid_t page_id, lsn_t lsn) {
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -40,6 +43,7 @@ lsn_t LogManager::AppendInsertLog(xid_t xid, oid_t oid, pageid_t page_id, slotid
     std::unique_lock lock(log_buffer_mutex_);
     log_buffer_.push_back(std::move(log));
   }
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -58,6 +62,28 @@ lsn_t LogManager::AppendDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid
     std::unique_lock lock(log_buffer_mutex_);
     log_buffer_.push_back(std::move(log));
   }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendUpdateLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t old_slot_id, slotid_t new_slot_id,
+                                  db_size_t offset, db_size_t size, char *new_record) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendUpdateLog)");
+  }
+  auto log = std::make_shared<UpdateLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, old_slot_id, new_slot_id, offset,
+                                         size, new_record);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  att_[xid] = lsn;
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -85,6 +111,7 @@ lsn_t LogManager::AppendNewPageLog(xid_t xid, oid_t oid, pageid_t prev_page_id,
     std::unique_lock lock(log_buffer_mutex_);
     log_buffer_.push_back(std::move(log));
   }
+  std::scoped_lock lock(dpt_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -141,6 +168,106 @@ lsn_t LogManager::AppendRollbackLog(xid_t xid) {
   return lsn;
 }
 
+lsn_t LogManager::AppendPaxInsertLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id, db_size_t size,
+                                     char *new_record) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendPaxInsertLog)");
+  }
+  auto log = std::make_shared<PaxInsertLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, slot_id, size, new_record);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  att_[xid] = lsn;
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendPaxDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id) {
+  if (att_.find(xid) == att_.end()) {
+    throw DbException(std::to_string(xid) + " does not exist in att (in AppendPaxDeleteLog)");
+  }
+  auto log = std::make_shared<PaxDeleteLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, slot_id);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  att_[xid] = lsn;
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendPaxCompressLog(oid_t oid, pageid_t page_id) {
+  auto log = std::make_shared<PaxCompressLog>(NULL_LSN, NULL_XID, NULL_LSN, oid, page_id);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendVacuumLog(oid_t oid, pageid_t page_id, xid_t oldest_xmin) {
+  auto log = std::make_shared<VacuumLog>(NULL_LSN, NULL_XID, NULL_LSN, oid, page_id, oldest_xmin);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendTruncateLog(oid_t oid, pageid_t page_count) {
+  auto log = std::make_shared<TruncateLog>(NULL_LSN, NULL_XID, NULL_LSN, oid, page_count);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_count - 1}) == dpt_.end()) {
+    dpt_[{oid, page_count - 1}] = lsn;
+  }
+  return lsn;
+}
+
+lsn_t LogManager::AppendOverflowLog(oid_t oid, pageid_t page_id, db_size_t page_offset, db_size_t size,
+                                    const char *data) {
+  auto log = std::make_shared<OverflowLog>(NULL_LSN, NULL_XID, NULL_LSN, oid, page_id, page_offset, size, data);
+  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
+  log->SetLSN(lsn);
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    log_buffer_.push_back(std::move(log));
+  }
+  std::scoped_lock lock(dpt_mutex_);
+  if (dpt_.find({oid, page_id}) == dpt_.end()) {
+    dpt_[{oid, page_id}] = lsn;
+  }
+  return lsn;
+}
+
 lsn_t LogManager::Checkpoint(bool async) {
   auto begin_checkpoint_log = std::make_shared<BeginCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN);
   lsn_t begin_lsn = next_lsn_.fetch_add(begin_checkpoint_log->GetSize(), std::memory_order_relaxed);
@@ -150,7 +277,12 @@ lsn_t LogManager::Checkpoint(bool async) {
     log_buffer_.push_back(std::move(begin_checkpoint_log));
   }
 
-  auto end_checkpoint_log = std::make_shared<EndCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN, att_, dpt_);
+  std::unordered_map<TablePageid, lsn_t> dpt;
+  {
+    std::scoped_lock lock(dpt_mutex_);
+    dpt = dpt_;
+  }
+  auto end_checkpoint_log = std::make_shared<EndCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN, att_, dpt);
   lsn_t end_lsn = next_lsn_.fetch_add(end_checkpoint_log->GetSize(), std::memory_order_relaxed);
   end_checkpoint_log->SetLSN(end_lsn);
   {
@@ -165,6 +297,7 @@ lsn_t LogManager::Checkpoint(bool async) {
 
 void LogManager::FlushPage(oid_t table_oid, pageid_t page_id, lsn_t page_lsn) {
   Flush(page_lsn);
+  std::scoped_lock lock(dpt_mutex_);
   dpt_.erase({table_oid, page_id});
 }
 
@@ -173,10 +306,31 @@ void LogManager::Rollback(xid_t xid) {
   // 依次获取 lsn 的 prev_lsn_，直到 NULL_LSN
   // 根据 lsn 和 flushed_lsn_ 的大小关系，判断日志在 buffer 中还是在磁盘中
   // 若日志在 buffer 中，通过 log_buffer_ 获取日志
-  // 若日志在磁盘中，通过 disk_ 读取日志，count 参数可设置为 MAX_LOG_SIZE
-  // 通过 LogRecord::DeserializeFrom 函数解析日志
-  // 调用日志的 Undo 函数
-  // LAB 2 BEGIN
+  if (att_.find(xid) == att_.end()) {
+    return;
+  }
+  lsn_t lsn = att_.at(xid);
+  while (lsn != NULL_LSN) {
+    auto log = ReadLogRecord(lsn);
+    log->Undo(*buffer_pool_, *catalog_, *this, NULL_LSN);
+    lsn = log->GetPrevLSN();
+  }
+}
+
+std::shared_ptr<LogRecord> LogManager::ReadLogRecord(lsn_t lsn) {
+  {
+    std::unique_lock lock(log_buffer_mutex_);
+    for (const auto &log : log_buffer_) {
+      if (log->GetLSN() == lsn) {
+        return log;
+      }
+    }
+  }
+  char buf[MAX_LOG_SIZE];
+  auto end = next_lsn_.load();
+  uint32_t count = std::min<lsn_t>(MAX_LOG_SIZE, end - lsn);
+  disk_.ReadLog(lsn, count, buf);
+  return LogRecord::DeserializeFrom(lsn, buf);
 }
 
 void LogManager::Recover() {
@@ -192,25 +346,35 @@ uint32_t LogManager::GetRedoCount() const { return redo_count_; }
 void LogManager::Flush(lsn_t lsn) {
   size_t max_log_size = 0;
   lsn_t max_lsn = NULL_LSN;
-  {
-    std::unique_lock lock(log_buffer_mutex_);
-    for (auto iterator = log_buffer_.cbegin(); iterator != log_buffer_.cend();) {
-      const auto &log_record = *iterator;
-      // 如果 lsn 为 NULL_LSN，表示 log_buffer_ 中所有日志都需要刷盘
-      if (lsn != NULL_LSN && log_record->GetLSN() > lsn) {
-        iterator++;
-        continue;
-      }
-      auto log_size = log_record->GetSize();
-      auto log = std::make_unique<char[]>(log_size);
-      log_record->SerializeTo(log.get());
-      disk_.WriteLog(log_record->GetLSN(), log_size, log.get());
-      if (max_lsn == NULL_LSN || log_record->GetLSN() > max_lsn) {
-        max_lsn = log_record->GetLSN();
-        max_log_size = log_size;
-      }
-      iterator = log_buffer_.erase(iterator);
+  // 后台写线程与前台线程可能同时刷日志，flushed_lsn_ 和 NEXT_LSN_NAME 文件的更新也需在锁内进行
+  std::unique_lock lock(log_buffer_mutex_);
+  // 先序列化所有需要刷盘的日志，再批量提交写入
+  std::vector<std::unique_ptr<char[]>> logs;
+  std::vector<LogIO> log_ios;
+  std::vector<decltype(log_buffer_)::const_iterator> flushed;
+  for (auto iterator = log_buffer_.cbegin(); iterator != log_buffer_.cend(); iterator++) {
+    const auto &log_record = *iterator;
+    // 如果 lsn 为 NULL_LSN，表示 log_buffer_ 中所有日志都需要刷盘
+    if (lsn != NULL_LSN && log_record->GetLSN() > lsn) {
+      continue;
     }
+    auto log_size = log_record->GetSize();
+    auto log = std::make_unique<char[]>(log_size);
+    log_record->SerializeTo(log.get());
+    log_ios.push_back({static_cast<uint32_t>(log_record->GetLSN()), static_cast<uint32_t>(log_size), log.get()});
+    logs.push_back(std::move(log));
+    if (max_lsn == NULL_LSN || log_record->GetLSN() > max_lsn) {
+      max_lsn = log_record->GetLSN();
+      max_log_size = log_size;
+    }
+    flushed.push_back(iterator);
+  }
+  if (!log_ios.empty()) {
+    disk_.WriteLogs(log_ios);
+  }
+  // 写入成功后再从 log_buffer_ 中移除日志
+  for (const auto &iterator : flushed) {
+    log_buffer_.erase(iterator);
   }
   // 如果 max_lsn 为 NULL_LSN，表示没有日志刷盘
   // 如果 flushed_lsn_ 为 NULL_LSN，表示还没有日志刷过盘
@@ -246,19 +410,88 @@ void LogManager::Analyze() {
     std::ifstream in(MASTER_RECORD_NAME);
     in >> checkpoint_lsn;
   }
-  // 根据 Checkpoint 日志恢复脏页表、活跃事务表等元信息
-  // 必要时调用 transaction_manager_.SetNextXid 来恢复事务 id
-  // LAB 2 BEGIN
+  att_.clear();
+  dpt_.clear();
+  lsn_t lsn = checkpoint_lsn;
+  while (lsn < next_lsn_) {
+    auto log = ReadLogRecord(lsn);
+    auto xid = log->GetXid();
+    switch (log->GetType()) {
+      case LogType::END_CHECKPOINT: {
+        auto ck = std::dynamic_pointer_cast<EndCheckpointLog>(log);
+        for (auto [x, l] : ck->GetATT()) if (att_.find(x) == att_.end()) att_[x] = l;
+        for (auto [p, l] : ck->GetDPT()) if (dpt_.find(p) == dpt_.end()) dpt_[p] = l;
+        break;
+      }
+      case LogType::BEGIN_CHECKPOINT:
+        break;
+      case LogType::COMMIT:
+      case LogType::ROLLBACK:
+        att_.erase(xid);
+        transaction_manager_.SetNextXid(xid + 1);
+        break;
+      default:
+        if (xid != NULL_XID && xid != DDL_XID) {
+          att_[xid] = lsn;
+          transaction_manager_.SetNextXid(xid + 1);
+        }
+        if (log->GetType() == LogType::INSERT) {
+          auto l = std::dynamic_pointer_cast<InsertLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::DELETE) {
+          auto l = std::dynamic_pointer_cast<DeleteLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::NEW_PAGE) {
+          auto l = std::dynamic_pointer_cast<NewPageLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+          if (l->GetPrevPageId() != NULL_PAGE_ID && !dpt_.count({l->GetOid(), l->GetPrevPageId()})) dpt_[{l->GetOid(), l->GetPrevPageId()}] = lsn;
+        } else if (log->GetType() == LogType::UPDATE) {
+          auto l = std::dynamic_pointer_cast<UpdateLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::PAX_INSERT) {
+          auto l = std::dynamic_pointer_cast<PaxInsertLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::PAX_DELETE) {
+          auto l = std::dynamic_pointer_cast<PaxDeleteLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::PAX_COMPRESS) {
+          auto l = std::dynamic_pointer_cast<PaxCompressLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::OVERFLOW) {
+          auto l = std::dynamic_pointer_cast<OverflowLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::VACUUM) {
+          auto l = std::dynamic_pointer_cast<VacuumLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetPageId()})) dpt_[{l->GetOid(), l->GetPageId()}] = lsn;
+        } else if (log->GetType() == LogType::TRUNCATE) {
+          auto l = std::dynamic_pointer_cast<TruncateLog>(log);
+          if (!dpt_.count({l->GetOid(), l->GetLastPageId()})) dpt_[{l->GetOid(), l->GetLastPageId()}] = lsn;
+        }
+    }
+    lsn += log->GetSize();
+  }
 }
 
 void LogManager::Redo() {
-  // 正序读取日志，调用日志记录的 Redo 函数
-  // LAB 2 BEGIN
+  if (dpt_.empty()) {
+    return;
+  }
+  lsn_t lsn = NULL_LSN;
+  for (auto [_, l] : dpt_) {
+    if (lsn == NULL_LSN || l < lsn) lsn = l;
+  }
+  while (lsn < next_lsn_) {
+    auto log = ReadLogRecord(lsn);
+    log->Redo(*buffer_pool_, *catalog_, *this);
+    lsn += log->GetSize();
+  }
 }
 
 void LogManager::Undo() {
-  // 根据活跃事务表，将所有活跃事务回滚
-  // LAB 2 BEGIN
+  for (auto [xid, _] : att_) {
+    Rollback(xid);
+  }
+  att_.clear();
 }
 
 }  // namespace huadb
@@ -37,10 +37,23 @@ class LogManager {
   lsn_t AppendInsertLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id, db_size_t offset, db_size_t size,
                         char *new_record);
   lsn_t AppendDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id);
+  // 页内更新，删除 old_slot_id 处的旧版本，并将新版本插入同一页面的 new_slot_id
+  lsn_t AppendUpdateLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t old_slot_id, slotid_t new_slot_id,
+                        db_size_t offset, db_size_t size, char *new_record);
   lsn_t AppendNewPageLog(xid_t xid, oid_t oid, pageid_t prev_page_id, pageid_t page_id);
   lsn_t AppendBeginLog(xid_t xid);
   lsn_t AppendCommitLog(xid_t xid);
   lsn_t AppendRollbackLog(xid_t xid);
+  // 列存表的插入和删除日志
+  lsn_t AppendPaxInsertLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id, db_size_t size, char *new_record);
+  lsn_t AppendPaxDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id);
+  // 列存表页面压缩的日志不属于任何事务
+  lsn_t AppendPaxCompressLog(oid_t oid, pageid_t page_id);
+  // VACUUM 的日志不属于任何事务
+  lsn_t AppendVacuumLog(oid_t oid, pageid_t page_id, xid_t oldest_xmin);
+  lsn_t AppendTruncateLog(oid_t oid, pageid_t page_count);
+  // 溢出页面的日志不属于任何事务，oid 为溢出文件的 oid
+  lsn_t AppendOverflowLog(oid_t oid, pageid_t page_id, db_size_t page_offset, db_size_t size, const char *data);
 
   // async: 是否异步刷盘（高级功能）
   lsn_t Checkpoint(bool async = false);
@@ -70,6 +83,7 @@ class LogManager {
   void Redo();
   // 恢复阶段，回滚所有活跃事务
   void Undo();
+  std::shared_ptr<LogRecord> ReadLogRecord(lsn_t lsn);
 
   Disk &disk_;
   TransactionManager &transaction_manager_;
@@ -78,6 +92,7 @@ class LogManager {
 
   std::unordered_map<xid_t, lsn_t> att_;        // 活跃事务表
   std::unordered_map<TablePageid, lsn_t> dpt_;  // 脏页表
+  std::mutex dpt_mutex_;                        // 保护脏页表，buffer pool 的后台写线程会并发修改脏页表
 
   // 下一条日志的 lsn
   std::atomic<lsn_t> next_lsn_;
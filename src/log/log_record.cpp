@@ -41,6 +41,20 @@ std::shared_ptr<LogRecord> LogRecord::DeserializeFrom(lsn_t lsn, const char *dat
       return BeginCheckpointLog::DeserializeFrom(lsn, data + sizeof(type));
     case LogType::END_CHECKPOINT:
       return EndCheckpointLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::VACUUM:
+      return VacuumLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::TRUNCATE:
+      return TruncateLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::UPDATE:
+      return UpdateLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::OVERFLOW:
+      return OverflowLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::PAX_INSERT:
+      return PaxInsertLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::PAX_DELETE:
+      return PaxDeleteLog::DeserializeFrom(lsn, data + sizeof(type));
+    case LogType::PAX_COMPRESS:
+      return PaxCompressLog::DeserializeFrom(lsn, data + sizeof(type));
     default:
       throw DbException("Unknown log type in DeserializeFrom");
   }
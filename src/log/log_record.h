@@ -22,6 +22,13 @@ enum class LogType : enum_t {
   NEW_PAGE,
   BEGIN_CHECKPOINT,
   END_CHECKPOINT,
+  VACUUM,
+  TRUNCATE,
+  UPDATE,
+  OVERFLOW,
+  PAX_INSERT,
+  PAX_DELETE,
+  PAX_COMPRESS,
 };
 
 class LogRecord {
@@ -1,5 +1,7 @@
 #include "log/log_records/delete_log.h"
 
+#include "table/table_page.h"
+
 namespace huadb {
 
 DeleteLog::DeleteLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, slotid_t slot_id)
@@ -40,9 +42,8 @@ std::shared_ptr<DeleteLog> DeleteLog::DeserializeFrom(lsn_t lsn, const char *dat
 }
 
 void DeleteLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
-  // 恢复删除的记录
-  // 通过 catalog_ 获取 db_oid
-  // LAB 2 BEGIN
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  TablePage(buffer_pool.FetchPageWrite(db_oid, oid_, page_id_)).UndoDeleteRecord(slot_id_);
 }
 
 void DeleteLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
@@ -50,8 +51,16 @@ void DeleteLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_
   if (!catalog.TableExists(oid_)) {
     return;
   }
-  // 根据日志信息进行重做
-  // LAB 2 BEGIN
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  // 如果页面不存在，表示页面已被之后的 VACUUM 截断，无需 redo
+  if (!buffer_pool.PageExists(db_oid, oid_, page_id_)) {
+    return;
+  }
+  TablePage page(buffer_pool.FetchPageWrite(db_oid, oid_, page_id_));
+  if (page.GetPageLSN() >= lsn_) return;
+  log_manager.IncrementRedoCount();
+  page.DeleteRecord(slot_id_, xid_);
+  page.SetPageLSN(lsn_);
 }
 
 oid_t DeleteLog::GetOid() const { return oid_; }
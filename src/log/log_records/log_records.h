@@ -7,4 +7,11 @@
 #include "log/log_records/end_checkpoint_log.h"
 #include "log/log_records/insert_log.h"
 #include "log/log_records/new_page_log.h"
+#include "log/log_records/overflow_log.h"
+#include "log/log_records/pax_compress_log.h"
+#include "log/log_records/pax_delete_log.h"
+#include "log/log_records/pax_insert_log.h"
 #include "log/log_records/rollback_log.h"
+#include "log/log_records/truncate_log.h"
+#include "log/log_records/update_log.h"
+#include "log/log_records/vacuum_log.h"
@@ -1,5 +1,7 @@
 #include "log/log_records/new_page_log.h"
 
+#include "table/table_page.h"
+
 namespace huadb {
 
 NewPageLog::NewPageLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t prev_page_id, pageid_t page_id)
@@ -47,8 +49,26 @@ void NewPageLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log
   if (!catalog.TableExists(oid_)) {
     return;
   }
-  // 根据日志信息进行重做
-  // LAB 2 BEGIN
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  WritePageGuard guard;
+  try {
+    guard = buffer_pool.FetchPageWrite(db_oid, oid_, page_id_);
+  } catch (DbException &) {
+    guard = buffer_pool.NewPage(db_oid, oid_, page_id_);
+  }
+  TablePage page(std::move(guard));
+  if (page.GetPageLSN() < lsn_) {
+    log_manager.IncrementRedoCount();
+    page.Init();
+    page.SetPageLSN(lsn_);
+  }
+  if (prev_page_id_ != NULL_PAGE_ID && buffer_pool.PageExists(db_oid, oid_, prev_page_id_)) {
+    TablePage prev(buffer_pool.FetchPageWrite(db_oid, oid_, prev_page_id_));
+    if (prev.GetPageLSN() < lsn_) {
+      prev.SetNextPageId(page_id_);
+      prev.SetPageLSN(lsn_);
+    }
+  }
 }
 
 oid_t NewPageLog::GetOid() const { return oid_; }
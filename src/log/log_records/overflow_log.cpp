@@ -0,0 +1,94 @@
+#include "log/log_records/overflow_log.h"
+
+#include "log/log_manager.h"
+#include "storage/disk.h"
+
+namespace huadb {
+
+OverflowLog::OverflowLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, db_size_t page_offset,
+                         db_size_t size, const char *data)
+    : LogRecord(LogType::OVERFLOW, lsn, xid, prev_lsn),
+      oid_(oid),
+      page_id_(page_id),
+      page_offset_(page_offset),
+      size_in_page_(size) {
+  data_ = new char[size_in_page_];
+  memcpy(data_, data, size_in_page_);
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(page_offset_) + sizeof(size_in_page_) + size_in_page_;
+}
+
+OverflowLog::~OverflowLog() { delete[] data_; }
+
+size_t OverflowLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  memcpy(data + offset, &page_offset_, sizeof(page_offset_));
+  offset += sizeof(page_offset_);
+  memcpy(data + offset, &size_in_page_, sizeof(size_in_page_));
+  offset += sizeof(size_in_page_);
+  memcpy(data + offset, data_, size_in_page_);
+  offset += size_in_page_;
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<OverflowLog> OverflowLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  db_size_t page_offset, size;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&page_offset, data + offset, sizeof(page_offset));
+  offset += sizeof(page_offset);
+  memcpy(&size, data + offset, sizeof(size));
+  offset += sizeof(size);
+  return std::make_shared<OverflowLog>(lsn, xid, prev_lsn, oid, page_id, page_offset, size, data + offset);
+}
+
+void OverflowLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果表不存在，表示该表已经被删除，无需 redo
+  auto table_oid = oid_ & ~OVERFLOW_OID_FLAG;
+  if (!catalog.TableExists(table_oid)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(table_oid);
+  auto path = Disk::GetFilePath(db_oid, oid_);
+  if (!Disk::FileExists(path)) {
+    Disk::CreateFile(path);
+  }
+  // 溢出页面可能尚未写回磁盘
+  auto page = buffer_pool.PageExists(db_oid, oid_, page_id_) ? buffer_pool.FetchPageWrite(db_oid, oid_, page_id_)
+                                                              : buffer_pool.NewPage(db_oid, oid_, page_id_);
+  lsn_t page_lsn;
+  memcpy(&page_lsn, page.GetData(), sizeof(page_lsn));
+  if (page_lsn >= lsn_) {
+    return;
+  }
+  log_manager.IncrementRedoCount();
+  memcpy(page.GetData() + page_offset_, data_, size_in_page_);
+  memcpy(page.GetData(), &lsn_, sizeof(lsn_));
+  page.SetDirty();
+}
+
+oid_t OverflowLog::GetOid() const { return oid_; }
+
+pageid_t OverflowLog::GetPageId() const { return page_id_; }
+
+std::string OverflowLog::ToString() const {
+  return fmt::format("OverflowLog\t\t[{}\toid: {}\tpage_id: {}\tpage_offset: {}\tsize: {}]", LogRecord::ToString(),
+                     oid_, page_id_, page_offset_, size_in_page_);
+}
+
+}  // namespace huadb
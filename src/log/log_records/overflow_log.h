@@ -0,0 +1,34 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 写入溢出页面的日志，记录写入溢出页面 page_offset 处的数据，重做时再次写入
+// 溢出数据写入后不再修改，回滚后不再被引用，日志无需撤销，不属于任何事务
+// oid 为溢出文件的 oid，即表的 oid 加上 OVERFLOW_OID_FLAG
+class OverflowLog : public LogRecord {
+ public:
+  OverflowLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, db_size_t page_offset,
+              db_size_t size, const char *data);
+  ~OverflowLog();
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<OverflowLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  db_size_t page_offset_;
+  db_size_t size_in_page_;
+  char *data_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,66 @@
+#include "log/log_records/pax_compress_log.h"
+
+#include "log/log_manager.h"
+#include "table/pax_page.h"
+
+namespace huadb {
+
+PaxCompressLog::PaxCompressLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id)
+    : LogRecord(LogType::PAX_COMPRESS, lsn, xid, prev_lsn), oid_(oid), page_id_(page_id) {
+  size_ += sizeof(oid_) + sizeof(page_id_);
+}
+
+size_t PaxCompressLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<PaxCompressLog> PaxCompressLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  return std::make_shared<PaxCompressLog>(lsn, xid, prev_lsn, oid, page_id);
+}
+
+void PaxCompressLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该表已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  // 压缩前页面中已有记录，页面不存在说明之前的插入日志也无需重做，页面已不存在
+  if (!buffer_pool.PageExists(db_oid, oid_, page_id_)) {
+    return;
+  }
+  PaxPage page(buffer_pool.FetchPageWrite(db_oid, oid_, page_id_), catalog.GetTableColumnList(oid_));
+  if (page.GetPageLSN() < lsn_) {
+    log_manager.IncrementRedoCount();
+    page.Compress();
+    page.SetPageLSN(lsn_);
+  }
+}
+
+oid_t PaxCompressLog::GetOid() const { return oid_; }
+
+pageid_t PaxCompressLog::GetPageId() const { return page_id_; }
+
+std::string PaxCompressLog::ToString() const {
+  return fmt::format("PaxCompressLog\t\t[{}\toid: {}\tpage_id: {}]", LogRecord::ToString(), oid_, page_id_);
+}
+
+}  // namespace huadb
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 压缩列存表页面的日志，压缩只取决于页面内容，重做时对页面再次压缩
+// 压缩不属于任何事务，日志无需撤销
+class PaxCompressLog : public LogRecord {
+ public:
+  PaxCompressLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<PaxCompressLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+};
+
+}  // namespace huadb
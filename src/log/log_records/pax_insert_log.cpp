@@ -0,0 +1,98 @@
+#include "log/log_records/pax_insert_log.h"
+
+#include "log/log_manager.h"
+#include "table/pax_page.h"
+
+namespace huadb {
+
+PaxInsertLog::PaxInsertLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, slotid_t slot_id,
+                           db_size_t record_size, char *record)
+    : LogRecord(LogType::PAX_INSERT, lsn, xid, prev_lsn),
+      oid_(oid),
+      page_id_(page_id),
+      slot_id_(slot_id),
+      record_size_(record_size) {
+  record_ = new char[record_size_];
+  memcpy(record_, record, record_size_);
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(slot_id_) + sizeof(record_size_) + record_size_;
+}
+
+PaxInsertLog::~PaxInsertLog() { delete[] record_; }
+
+size_t PaxInsertLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  memcpy(data + offset, &slot_id_, sizeof(slot_id_));
+  offset += sizeof(slot_id_);
+  memcpy(data + offset, &record_size_, sizeof(record_size_));
+  offset += sizeof(record_size_);
+  memcpy(data + offset, record_, record_size_);
+  offset += record_size_;
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<PaxInsertLog> PaxInsertLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  slotid_t slot_id;
+  db_size_t record_size;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&slot_id, data + offset, sizeof(slot_id));
+  offset += sizeof(slot_id);
+  memcpy(&record_size, data + offset, sizeof(record_size));
+  offset += sizeof(record_size);
+  return std::make_shared<PaxInsertLog>(lsn, xid, prev_lsn, oid, page_id, slot_id, record_size,
+                                        const_cast<char *>(data + offset));
+}
+
+void PaxInsertLog::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {
+  // 与行存表相同，回滚插入即由插入事务删除该记录
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  PaxPage(buffer_pool.FetchPageWrite(db_oid, oid_, page_id_), catalog.GetTableColumnList(oid_))
+      .DeleteRecord(slot_id_, xid_);
+}
+
+void PaxInsertLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该表已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  const auto &column_list = catalog.GetTableColumnList(oid_);
+  // 页面可能在写回磁盘前崩溃，新建的页面内容全为 0，即没有记录的 PAX 页面
+  auto page_guard = buffer_pool.PageExists(db_oid, oid_, page_id_) ? buffer_pool.FetchPageWrite(db_oid, oid_, page_id_)
+                                                                    : buffer_pool.NewPage(db_oid, oid_, page_id_);
+  PaxPage page(std::move(page_guard), column_list);
+  if (page.GetPageLSN() < lsn_) {
+    log_manager.IncrementRedoCount();
+    Record record;
+    record.DeserializeFrom(record_, column_list);
+    page.RedoInsertRecord(slot_id_, record);
+    page.SetPageLSN(lsn_);
+  }
+}
+
+oid_t PaxInsertLog::GetOid() const { return oid_; }
+
+pageid_t PaxInsertLog::GetPageId() const { return page_id_; }
+
+std::string PaxInsertLog::ToString() const {
+  return fmt::format("PaxInsertLog\t\t[{}\toid: {}\tpage_id: {}\tslot_id: {}\trecord_size: {}]", LogRecord::ToString(),
+                     oid_, page_id_, slot_id_, record_size_);
+}
+
+}  // namespace huadb
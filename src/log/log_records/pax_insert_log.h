@@ -0,0 +1,34 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 列存表插入记录的日志，record 为记录按行序列化的结果（包含记录头），重做时按列写入 PAX 页面
+// 列存表的页面不单独记录新建页面的日志，重做时页面不存在则新建页面
+class PaxInsertLog : public LogRecord {
+ public:
+  PaxInsertLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, slotid_t slot_id,
+               db_size_t record_size, char *record);
+  ~PaxInsertLog();
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<PaxInsertLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) override;
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  slotid_t slot_id_;
+  db_size_t record_size_;
+  char *record_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,65 @@
+#include "log/log_records/truncate_log.h"
+
+#include "table/table_page.h"
+
+namespace huadb {
+
+TruncateLog::TruncateLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_count)
+    : LogRecord(LogType::TRUNCATE, lsn, xid, prev_lsn), oid_(oid), page_count_(page_count) {
+  size_ += sizeof(oid_) + sizeof(page_count_);
+}
+
+size_t TruncateLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_count_, sizeof(page_count_));
+  offset += sizeof(page_count_);
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<TruncateLog> TruncateLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_count;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_count, data + offset, sizeof(page_count));
+  offset += sizeof(page_count);
+  return std::make_shared<TruncateLog>(lsn, xid, prev_lsn, oid, page_count);
+}
+
+void TruncateLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该表已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  {
+    TablePage page(buffer_pool.FetchPageWrite(db_oid, oid_, GetLastPageId()));
+    if (page.GetPageLSN() < lsn_) {
+      log_manager.IncrementRedoCount();
+      page.SetNextPageId(NULL_PAGE_ID);
+      page.SetPageLSN(lsn_);
+    }
+  }
+  // 截断是幂等的，之后重新创建的页面会由其 NewPageLog 再次创建
+  buffer_pool.TruncateFile(db_oid, oid_, page_count_);
+}
+
+oid_t TruncateLog::GetOid() const { return oid_; }
+
+pageid_t TruncateLog::GetLastPageId() const { return page_count_ - 1; }
+
+std::string TruncateLog::ToString() const {
+  return fmt::format("TruncateLog\t\t[{}\toid: {}\tpage_count: {}]", LogRecord::ToString(), oid_, page_count_);
+}
+
+}  // namespace huadb
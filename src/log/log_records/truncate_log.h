@@ -0,0 +1,29 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// VACUUM 截断表末尾空页面的日志，表被截断为 page_count 个页面，最后一个页面的 next_page_id 置为空
+// VACUUM 不属于任何事务，日志无需撤销
+class TruncateLog : public LogRecord {
+ public:
+  TruncateLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_count);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<TruncateLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  // 截断后表的最后一个页面
+  pageid_t GetLastPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_count_;
+};
+
+}  // namespace huadb
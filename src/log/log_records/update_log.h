@@ -0,0 +1,36 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 页内更新的日志，一条日志同时记录旧版本的删除和新版本的插入，两个版本位于同一页面
+// 新版本紧跟旧版本插入页面，old_slot_id 与 new_slot_id 记录两个版本之间的链接
+class UpdateLog : public LogRecord {
+ public:
+  UpdateLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, slotid_t old_slot_id,
+            slotid_t new_slot_id, db_size_t page_offset, db_size_t record_size, char *record);
+  ~UpdateLog();
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<UpdateLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) override;
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  slotid_t old_slot_id_;
+  slotid_t new_slot_id_;
+  db_size_t page_offset_;
+  db_size_t record_size_;
+  char *record_;
+};
+
+}  // namespace huadb
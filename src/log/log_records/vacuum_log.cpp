@@ -0,0 +1,71 @@
+#include "log/log_records/vacuum_log.h"
+
+#include "table/table_page.h"
+
+namespace huadb {
+
+VacuumLog::VacuumLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, xid_t oldest_xmin)
+    : LogRecord(LogType::VACUUM, lsn, xid, prev_lsn), oid_(oid), page_id_(page_id), oldest_xmin_(oldest_xmin) {
+  size_ += sizeof(oid_) + sizeof(page_id_) + sizeof(oldest_xmin_);
+}
+
+size_t VacuumLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  memcpy(data + offset, &page_id_, sizeof(page_id_));
+  offset += sizeof(page_id_);
+  memcpy(data + offset, &oldest_xmin_, sizeof(oldest_xmin_));
+  offset += sizeof(oldest_xmin_);
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<VacuumLog> VacuumLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t oid;
+  pageid_t page_id;
+  xid_t oldest_xmin;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_id, data + offset, sizeof(page_id));
+  offset += sizeof(page_id);
+  memcpy(&oldest_xmin, data + offset, sizeof(oldest_xmin));
+  offset += sizeof(oldest_xmin);
+  return std::make_shared<VacuumLog>(lsn, xid, prev_lsn, oid, page_id, oldest_xmin);
+}
+
+void VacuumLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该表已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  auto db_oid = catalog.GetDatabaseOid(oid_);
+  // 如果页面不存在，表示页面已被之后的 VACUUM 截断，无需 redo
+  if (!buffer_pool.PageExists(db_oid, oid_, page_id_)) {
+    return;
+  }
+  TablePage page(buffer_pool.FetchPageWrite(db_oid, oid_, page_id_));
+  if (page.GetPageLSN() < lsn_) {
+    log_manager.IncrementRedoCount();
+    page.Vacuum(oldest_xmin_);
+    page.SetPageLSN(lsn_);
+  }
+}
+
+oid_t VacuumLog::GetOid() const { return oid_; }
+
+pageid_t VacuumLog::GetPageId() const { return page_id_; }
+
+std::string VacuumLog::ToString() const {
+  return fmt::format("VacuumLog\t\t[{}\toid: {}\tpage_id: {}\toldest_xmin: {}]", LogRecord::ToString(), oid_, page_id_,
+                     oldest_xmin_);
+}
+
+}  // namespace huadb
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// VACUUM 回收页面中记录的日志，重做时以相同的 oldest_xmin 再次回收页面
+// VACUUM 不属于任何事务，日志无需撤销
+class VacuumLog : public LogRecord {
+ public:
+  VacuumLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t oid, pageid_t page_id, xid_t oldest_xmin);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<VacuumLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetOid() const;
+  pageid_t GetPageId() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t oid_;
+  pageid_t page_id_;
+  xid_t oldest_xmin_;
+};
+
+}  // namespace huadb
@@ -25,6 +25,12 @@ class Arithmetic : public OperatorExpression {
     return Compute(lhs, rhs);
   }
 
+  Value EvaluateView(const RecordView &view) override {
+    Value lhs = children_[0]->EvaluateView(view);
+    Value rhs = children_[1]->EvaluateView(view);
+    return Compute(lhs, rhs);
+  }
+
   std::string ToString() const override { return fmt::format("{} {} {}", children_[0], type_, children_[1]); }
 
  private:
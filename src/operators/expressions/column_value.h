@@ -21,6 +21,7 @@ class ColumnValue : public OperatorExpression {
       return right->GetValue(col_idx_);
     }
   }
+  Value EvaluateView(const RecordView &view) override { return view.GetValue(col_idx_); }
   std::string ToString() const override { return fmt::format("{}", name_); }
   size_t GetColumnIndex() const { return col_idx_; }
 
@@ -40,6 +40,11 @@ class Comparison : public OperatorExpression {
     Value rhs = children_[1]->EvaluateJoin(left, right);
     return Compute(lhs, rhs);
   }
+  Value EvaluateView(const RecordView &view) override {
+    Value lhs = children_[0]->EvaluateView(view);
+    Value rhs = children_[1]->EvaluateView(view);
+    return Compute(lhs, rhs);
+  }
   std::string ToString() const override { return fmt::format("{} {} {}", children_[0], type_, children_[1]); }
   ComparisonType GetComparisonType() { return type_; }
 
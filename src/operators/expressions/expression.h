@@ -8,6 +8,7 @@
 #include "common/value.h"
 #include "fmt/format.h"
 #include "table/record.h"
+#include "table/record_view.h"
 
 namespace huadb {
 
@@ -38,6 +39,8 @@ class OperatorExpression {
   virtual Value EvaluateJoin(std::shared_ptr<const Record> left, std::shared_ptr<const Record> right) {
     throw DbException("EvaluateJoin method not implemented");
   }
+  // 在页面中的记录视图上求值，只构造用到的列的值
+  virtual Value EvaluateView(const RecordView &view) { throw DbException("EvaluateView method not implemented"); }
   virtual std::string ToString() const { return "OperatorExpression"; }
 
   OperatorExpressionType GetExprType() const { return expr_type_; }
@@ -42,6 +42,16 @@ class FuncCall : public OperatorExpression {
     }
     throw std::runtime_error("Unknown function name " + function_name_);
   }
+  Value EvaluateView(const RecordView &view) override {
+    if (function_name_ == "lower") {
+      return Value(StringUtil::Lower(args_[0]->EvaluateView(view).GetValue<std::string>()));
+    } else if (function_name_ == "upper") {
+      return Value(StringUtil::Upper(args_[0]->EvaluateView(view).GetValue<std::string>()));
+    } else if (function_name_ == "length") {
+      return Value(static_cast<uint32_t>(args_[0]->EvaluateView(view).GetValue<std::string>().size()));
+    }
+    throw std::runtime_error("Unknown function name " + function_name_);
+  }
   std::string ToString() const override { return fmt::format("{}({})", function_name_, args_); }
   std::string function_name_;
   std::vector<std::shared_ptr<OperatorExpression>> args_;
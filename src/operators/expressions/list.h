@@ -23,6 +23,13 @@ class List : public OperatorExpression {
     }
     return Value(values);
   }
+  Value EvaluateView(const RecordView &view) override {
+    std::vector<Value> values;
+    for (auto &e : exprs_) {
+      values.push_back(e->EvaluateView(view));
+    }
+    return Value(values);
+  }
   std::string ToString() const override { return fmt::format("{}", exprs_); }
   std::vector<std::shared_ptr<OperatorExpression>> exprs_;
 };
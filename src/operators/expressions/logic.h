@@ -41,6 +41,16 @@ class Logic : public OperatorExpression {
     }
   }
 
+  Value EvaluateView(const RecordView &view) override {
+    if (logic_type_ == LogicType::NOT) {
+      return children_[0]->EvaluateView(view).Not();
+    } else {
+      Value lhs = children_[0]->EvaluateView(view);
+      Value rhs = children_[1]->EvaluateView(view);
+      return Compute(lhs, rhs);
+    }
+  }
+
   std::string ToString() const override {
     if (logic_type_ == LogicType::NOT) {
       return fmt::format("{} {}", logic_type_, children_[0]);
@@ -2,7 +2,7 @@
 
 #include <optional>
 
-#include "fmt/format.h"
+#include "fmt/ranges.h"
 #include "operators/operator.h"
 #include "table/table.h"
 #include "table/table_scan.h"
@@ -19,10 +19,14 @@ class SeqScanOperator : public Operator {
         alias_(std::move(alias)),
         has_lock_(has_lock) {}
   std::string ToString(size_t indent_num = 0) const override {
+    std::string columns;
+    if (column_ids_) {
+      columns = fmt::format(" columns={}", *column_ids_);
+    }
     if (alias_) {
-      return fmt::format("{}SeqScan: {} {}", std::string(indent_num * 2, ' '), table_name_, *alias_);
+      return fmt::format("{}SeqScan: {} {}{}", std::string(indent_num * 2, ' '), table_name_, *alias_, columns);
     } else {
-      return fmt::format("{}SeqScan: {}", std::string(indent_num * 2, ' '), table_name_);
+      return fmt::format("{}SeqScan: {}{}", std::string(indent_num * 2, ' '), table_name_, columns);
     }
   }
 
@@ -37,6 +41,11 @@ class SeqScanOperator : public Operator {
   const std::string &GetTableName() const { return table_name_; }
   bool HasLock() const { return has_lock_; }
 
+  // 列存表扫描需要解码的列，由优化器根据上层算子用到的列设置，为空时解码全部列
+  std::optional<std::vector<size_t>> column_ids_;
+  // 上层 Filter 中列与常量的比较限定的列取值范围，由优化器设置，扫描据此跳过区域映射表明不可能满足条件的页面
+  std::vector<ScanRange> ranges_;
+
  private:
   oid_t table_oid_;
   std::string table_name_;
@@ -1,5 +1,9 @@
 #include "optimizer/optimizer.h"
 
+#include "catalog/system_view.h"
+#include "operators/expressions/expressions.h"
+#include "operators/operators.h"
+
 namespace huadb {
 
 Optimizer::Optimizer(Catalog &catalog, JoinOrderAlgorithm join_order_algorithm, bool enable_projection_pushdown)
@@ -11,6 +15,8 @@ std::shared_ptr<Operator> Optimizer::Optimize(std::shared_ptr<Operator> plan) {
   plan = SplitPredicates(plan);
   plan = PushDown(plan);
   plan = ReorderJoin(plan);
+  PruneColumnarScans(plan);
+  AttachScanRanges(plan);
   return plan;
 }
 
@@ -88,4 +94,205 @@ std::shared_ptr<Operator> Optimizer::ReorderJoin(std::shared_ptr<Operator> plan)
   return plan;
 }
 
+void Optimizer::PruneColumnarScans(const std::shared_ptr<Operator> &plan) {
+  if (plan->GetType() == OperatorType::PROJECTION || plan->GetType() == OperatorType::AGGREGATE) {
+    // 沿不改变记录格式的算子向下查找扫描节点，LockRows 需要完整的记录，不在此列
+    auto node = plan->children_[0];
+    while (node->GetType() == OperatorType::FILTER || node->GetType() == OperatorType::ORDERBY ||
+           node->GetType() == OperatorType::LIMIT) {
+      node = node->children_[0];
+    }
+    if (node->GetType() == OperatorType::SEQSCAN) {
+      auto scan = std::dynamic_pointer_cast<SeqScanOperator>(node);
+      if (SystemView::IsSystemView(scan->GetTableOid()) ||
+          catalog_.GetTable(scan->GetTableOid())->GetStorageType() == StorageType::ROW) {
+        return;
+      }
+      std::vector<std::shared_ptr<OperatorExpression>> exprs;
+      if (plan->GetType() == OperatorType::PROJECTION) {
+        exprs = std::dynamic_pointer_cast<ProjectionOperator>(plan)->exprs_;
+      } else {
+        auto aggregate = std::dynamic_pointer_cast<AggregateOperator>(plan);
+        exprs = aggregate->group_bys_;
+        exprs.insert(exprs.end(), aggregate->aggregates_.begin(), aggregate->aggregates_.end());
+      }
+      for (auto child = plan->children_[0]; child != node; child = child->children_[0]) {
+        if (child->GetType() == OperatorType::FILTER) {
+          exprs.push_back(std::dynamic_pointer_cast<FilterOperator>(child)->predicate_);
+        } else if (child->GetType() == OperatorType::ORDERBY) {
+          for (const auto &[type, expr] : std::dynamic_pointer_cast<OrderByOperator>(child)->order_bys_) {
+            exprs.push_back(expr);
+          }
+        }
+      }
+      std::vector<bool> columns(scan->OutputColumns().Length(), false);
+      for (const auto &expr : exprs) {
+        if (!CollectColumns(expr, columns)) {
+          return;
+        }
+      }
+      std::vector<size_t> column_ids;
+      for (size_t i = 0; i < columns.size(); i++) {
+        if (columns[i]) {
+          column_ids.push_back(i);
+        }
+      }
+      if (column_ids.size() < columns.size()) {
+        scan->column_ids_ = std::move(column_ids);
+      }
+      return;
+    }
+  }
+  for (const auto &child : plan->children_) {
+    PruneColumnarScans(child);
+  }
+}
+
+bool Optimizer::CollectColumns(const std::shared_ptr<OperatorExpression> &expr, std::vector<bool> &columns) {
+  if (expr == nullptr) {
+    return true;
+  }
+  std::vector<std::shared_ptr<OperatorExpression>> children = expr->children_;
+  switch (expr->GetExprType()) {
+    case OperatorExpressionType::COLUMN_VALUE: {
+      auto col_idx = std::dynamic_pointer_cast<ColumnValue>(expr)->GetColumnIndex();
+      if (col_idx >= columns.size()) {
+        return false;
+      }
+      columns[col_idx] = true;
+      break;
+    }
+    case OperatorExpressionType::FUNC_CALL:
+      children = std::dynamic_pointer_cast<FuncCall>(expr)->args_;
+      break;
+    case OperatorExpressionType::LIST:
+      children = std::dynamic_pointer_cast<List>(expr)->exprs_;
+      break;
+    case OperatorExpressionType::NULL_TEST:
+      children = {std::dynamic_pointer_cast<NullTest>(expr)->arg_};
+      break;
+    case OperatorExpressionType::TYPE_CAST:
+      children = {std::dynamic_pointer_cast<TypeCast>(expr)->arg_};
+      break;
+    case OperatorExpressionType::AGGREGATE:
+    case OperatorExpressionType::ARITHMETIC:
+    case OperatorExpressionType::COMPARISON:
+    case OperatorExpressionType::CONST:
+    case OperatorExpressionType::LOGIC:
+      break;
+    default:
+      return false;
+  }
+  for (const auto &child : children) {
+    if (!CollectColumns(child, columns)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Optimizer::AttachScanRanges(const std::shared_ptr<Operator> &plan) {
+  auto node = plan;
+  std::vector<std::shared_ptr<OperatorExpression>> predicates;
+  while (node->GetType() == OperatorType::FILTER) {
+    predicates.push_back(std::dynamic_pointer_cast<FilterOperator>(node)->predicate_);
+    node = node->children_[0];
+  }
+  if (node->GetType() == OperatorType::SEQSCAN) {
+    auto scan = std::dynamic_pointer_cast<SeqScanOperator>(node);
+    if (SystemView::IsSystemView(scan->GetTableOid())) {
+      return;
+    }
+    for (const auto &predicate : predicates) {
+      CollectRanges(predicate, scan->OutputColumns().Length(), scan->ranges_);
+    }
+    return;
+  }
+  for (const auto &child : node->children_) {
+    AttachScanRanges(child);
+  }
+}
+
+void Optimizer::CollectRanges(const std::shared_ptr<OperatorExpression> &expr, size_t column_count,
+                              std::vector<ScanRange> &ranges) {
+  if (expr->GetExprType() == OperatorExpressionType::LOGIC) {
+    if (std::dynamic_pointer_cast<Logic>(expr)->GetLogicType() == LogicType::AND) {
+      CollectRanges(expr->children_[0], column_count, ranges);
+      CollectRanges(expr->children_[1], column_count, ranges);
+    }
+    return;
+  }
+  if (expr->GetExprType() != OperatorExpressionType::COMPARISON) {
+    return;
+  }
+  auto type = std::dynamic_pointer_cast<Comparison>(expr)->GetComparisonType();
+  auto column = expr->children_[0];
+  std::vector<std::shared_ptr<OperatorExpression>> bounds = {expr->children_[1]};
+  if (type == ComparisonType::BETWEEN) {
+    if (bounds[0]->GetExprType() != OperatorExpressionType::LIST) {
+      return;
+    }
+    bounds = std::dynamic_pointer_cast<List>(bounds[0])->exprs_;
+  } else if (column->GetExprType() == OperatorExpressionType::CONST) {
+    // 常量在左侧时交换两侧，比较方向随之反转
+    std::swap(column, bounds[0]);
+    if (type == ComparisonType::LESS) {
+      type = ComparisonType::GREATER;
+    } else if (type == ComparisonType::LESS_EQUAL) {
+      type = ComparisonType::GREATER_EQUAL;
+    } else if (type == ComparisonType::GREATER) {
+      type = ComparisonType::LESS;
+    } else if (type == ComparisonType::GREATER_EQUAL) {
+      type = ComparisonType::LESS_EQUAL;
+    }
+  }
+  if (column->GetExprType() != OperatorExpressionType::COLUMN_VALUE) {
+    return;
+  }
+  std::vector<Value> values;
+  for (const auto &bound : bounds) {
+    if (bound->GetExprType() != OperatorExpressionType::CONST) {
+      return;
+    }
+    values.push_back(std::dynamic_pointer_cast<Const>(bound)->value_);
+    if (values.back().IsNull()) {
+      return;
+    }
+  }
+  ScanRange range;
+  range.column_id_ = std::dynamic_pointer_cast<ColumnValue>(column)->GetColumnIndex();
+  if (range.column_id_ >= column_count) {
+    return;
+  }
+  switch (type) {
+    case ComparisonType::EQUAL:
+      range.lower_ = range.upper_ = values[0];
+      break;
+    case ComparisonType::LESS:
+      range.upper_inclusive_ = false;
+      range.upper_ = values[0];
+      break;
+    case ComparisonType::LESS_EQUAL:
+      range.upper_ = values[0];
+      break;
+    case ComparisonType::GREATER:
+      range.lower_inclusive_ = false;
+      range.lower_ = values[0];
+      break;
+    case ComparisonType::GREATER_EQUAL:
+      range.lower_ = values[0];
+      break;
+    case ComparisonType::BETWEEN:
+      if (values.size() != 2) {
+        return;
+      }
+      range.lower_ = values[0];
+      range.upper_ = values[1];
+      break;
+    default:
+      return;
+  }
+  ranges.push_back(std::move(range));
+}
+
 }  // namespace huadb
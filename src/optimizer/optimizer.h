@@ -1,7 +1,9 @@
 #pragma once
 
 #include "catalog/catalog.h"
+#include "operators/expressions/expression.h"
 #include "operators/operator.h"
+#include "table/zone_map.h"
 
 namespace huadb {
 
@@ -23,6 +25,20 @@ class Optimizer {
 
   std::shared_ptr<Operator> ReorderJoin(std::shared_ptr<Operator> plan);
 
+  // 列存表的只读扫描只解码上层算子用到的列
+  // 匹配 Projection 或 Aggregate 经过若干 Filter、OrderBy、Limit 到达列存表 SeqScan 的链，收集链上表达式引用的列
+  void PruneColumnarScans(const std::shared_ptr<Operator> &plan);
+  // 将表达式引用的列加入 columns，遇到无法识别的表达式时返回 false
+  static bool CollectColumns(const std::shared_ptr<OperatorExpression> &expr, std::vector<bool> &columns);
+
+  // 将直接位于 SeqScan 之上的 Filter 链中列与常量的比较转换为列取值范围，设置到 SeqScan 上用于跳过页面
+  // Filter 仍保留在原位置，取值范围只用于跳过页面，读到的记录仍由 Filter 判断
+  void AttachScanRanges(const std::shared_ptr<Operator> &plan);
+  // 从以 AND 连接的谓词中提取 EQUAL、LESS、LESS_EQUAL、GREATER、GREATER_EQUAL 和 BETWEEN 比较的取值范围
+  // 其余谓词不限定取值范围，忽略即可
+  static void CollectRanges(const std::shared_ptr<OperatorExpression> &expr, size_t column_count,
+                            std::vector<ScanRange> &ranges);
+
   JoinOrderAlgorithm join_order_algorithm_;
   bool enable_projection_pushdown_;
   Catalog &catalog_;
@@ -1,109 +1,936 @@
 #include "storage/buffer_pool.h"
 
-#include "common/constants.h"
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
 #include "common/exceptions.h"
 #include "log/log_manager.h"
+#include "storage/clock_buffer_strategy.h"
+#include "storage/lru_buffer_strategy.h"
+#include "storage/lru_k_buffer_strategy.h"
+#include "storage/two_queue_buffer_strategy.h"
 #include "table/table_page.h"
 
 namespace huadb {
 
-BufferPool::BufferPool(Disk &disk, LogManager &log_manager) : disk_(disk), log_manager_(log_manager) {
-  buffers_.reserve(BUFFER_SIZE);
-  hashmap_.reserve(BUFFER_SIZE);
-  buffer_strategy_ = std::make_unique<LRUBufferStrategy>();
+BufferPool::BufferPool(Disk &disk, LogManager &log_manager, size_t buffer_size)
+    : disk_(disk), log_manager_(log_manager), page_size_(disk.GetPageSize()) {
+  AllocateCatalogFrames(DEFAULT_CATALOG_BUFFER_SIZE);
+  AllocateFrames(buffer_size);
+}
+
+BufferPool::~BufferPool() {
+  StopPrewarm();
+  StopReadAheadWorkers();
+  StopBackgroundWriter();
 }
 
-std::shared_ptr<Page> BufferPool::GetPage(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+ReadPageGuard BufferPool::FetchPageRead(oid_t db_oid, oid_t table_oid, pageid_t page_id, BufferRing *ring) {
   if (page_id == NULL_PAGE_ID) {
-    throw DbException("Invalid page id in BufferPool::GetPage");
-  }
-  auto &buffers = (db_oid == SYSTEM_DATABASE_OID) ? systable_buffers_ : buffers_;
-  auto &hashmap = (db_oid == SYSTEM_DATABASE_OID) ? systable_hashmap_ : hashmap_;
-  auto entry = hashmap.find({table_oid, page_id});
-  if (entry == hashmap.end()) {
-    auto page = std::make_shared<Page>();
-    disk_.ReadPage(Disk::GetFilePath(db_oid, table_oid), page_id, page->GetData());
-    AddToBuffer(db_oid, table_oid, page_id, page);
-    return page;
-  } else {
-    if (db_oid != SYSTEM_DATABASE_OID) {
-      buffer_strategy_->Access(entry->second);
-    }
-    return buffers[entry->second].page_;
+    throw DbException("Invalid page id in BufferPool::FetchPageRead");
+  }
+  auto frame_id = FetchGuardFrame(db_oid, table_oid, page_id, FetchMode::READ, ring, false);
+  return ReadPageGuard(this, frame_id, buffers_[frame_id].page_.get());
+}
+
+WritePageGuard BufferPool::FetchPageWrite(oid_t db_oid, oid_t table_oid, pageid_t page_id, BufferRing *ring) {
+  if (page_id == NULL_PAGE_ID) {
+    throw DbException("Invalid page id in BufferPool::FetchPageWrite");
   }
+  auto frame_id = FetchGuardFrame(db_oid, table_oid, page_id, FetchMode::READ, ring, true);
+  return WritePageGuard(this, frame_id, buffers_[frame_id].page_.get());
 }
 
-std::shared_ptr<Page> BufferPool::NewPage(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+WritePageGuard BufferPool::NewPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, BufferRing *ring) {
   if (page_id == NULL_PAGE_ID) {
     throw DbException("Invalid page id in BufferPool::NewPage");
   }
-  auto page = std::make_shared<Page>();
-  AddToBuffer(db_oid, table_oid, page_id, page);
-  return page;
+  auto frame_id = FetchGuardFrame(db_oid, table_oid, page_id, FetchMode::NEW, ring, true);
+  return WritePageGuard(this, frame_id, buffers_[frame_id].page_.get());
 }
 
 void BufferPool::Flush(bool regular_only) {
-  for (size_t i = 0; i < buffers_.size(); i++) {
-    FlushPage(i);
+  std::unique_lock maintenance_lock(maintenance_mutex_);
+  FlushFrames(!regular_only);
+}
+
+void BufferPool::Clear() {
+  std::unique_lock maintenance_lock(maintenance_mutex_);
+  ResetFrames(true);
+}
+
+void BufferPool::CloseFile(oid_t db_oid, oid_t table_oid) { disk_.CloseFile(db_oid, table_oid); }
+
+void BufferPool::CloseDatabaseFiles(oid_t db_oid) { disk_.CloseDatabaseFiles(db_oid); }
+
+void BufferPool::TruncateFile(oid_t db_oid, oid_t table_oid, size_t page_count) {
+  // 阻止预读和预热线程在截断期间读入被截断的页面
+  std::unique_lock maintenance_lock(maintenance_mutex_);
+  for (auto *partition : GetPartitions(true)) {
+    std::scoped_lock lock(partition->latch_);
+    for (size_t i = partition->first_frame_; i < partition->first_frame_ + partition->frame_count_; i++) {
+      auto &buffer_entry = buffers_[i];
+      if (buffer_entry.page_id_ == NULL_PAGE_ID || buffer_entry.db_oid_ != db_oid ||
+          buffer_entry.table_oid_ != table_oid || buffer_entry.page_id_ < page_count) {
+        continue;
+      }
+      if (buffer_entry.pin_count_ > 0) {
+        throw DbException("Cannot truncate table while pages are pinned");
+      }
+      // 页帧不再对应任何页面，仍由替换策略管理，之后可被淘汰复用
+      partition->hashmap_.erase({table_oid, buffer_entry.page_id_});
+      buffer_entry.page_id_ = NULL_PAGE_ID;
+      buffer_entry.page_->Reset();
+    }
   }
-  buffers_.clear();
-  if (!regular_only) {
-    for (size_t i = 0; i < systable_buffers_.size(); i++) {
-      FlushSysTablePage(i);
+  disk_.TruncateFile(db_oid, table_oid, page_count);
+}
+
+bool BufferPool::PageExists(oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+  {
+    std::shared_lock maintenance_lock(maintenance_mutex_);
+    auto &partition = GetPartition(db_oid, {table_oid, page_id});
+    std::scoped_lock lock(partition.latch_);
+    if (partition.hashmap_.count({table_oid, page_id}) > 0) {
+      return true;
     }
-    systable_buffers_.clear();
   }
+  return page_id < disk_.GetPageCount(db_oid, table_oid);
 }
 
-void BufferPool::Clear() {
+void BufferPool::Resize(size_t buffer_size) {
+  if (buffer_size == 0) {
+    throw DbException("Buffer pool size must be positive");
+  }
+  std::unique_lock maintenance_lock(maintenance_mutex_);
+  // AllocateFrames 重新分配包括系统表页帧在内的所有页帧的 I/O 锁和页面锁，系统表页帧同样不能被 pin 住
+  if (HasPinnedFrames()) {
+    throw DbException("Cannot resize buffer pool while pages are pinned");
+  }
+  FlushFrames(false);
+  AllocateFrames(buffer_size);
+}
+
+size_t BufferPool::GetSize() const { return buffer_size_; }
+
+void BufferPool::ResizeCatalog(size_t catalog_buffer_size) {
+  if (catalog_buffer_size < MIN_CATALOG_BUFFER_SIZE) {
+    throw DbException("Catalog buffer size must be at least " + std::to_string(MIN_CATALOG_BUFFER_SIZE));
+  }
+  std::unique_lock maintenance_lock(maintenance_mutex_);
+  // 之后的 AllocateFrames 同样重新分配普通表页帧及所有页帧的锁，普通表页帧同样不能被 pin 住
+  if (HasPinnedFrames()) {
+    throw DbException("Cannot resize catalog buffer while pages are pinned");
+  }
+  // 系统表页帧排在普通表页帧之前，系统表页帧数目改变后普通表页帧也需重新分配
+  FlushFrames(true);
+  AllocateCatalogFrames(catalog_buffer_size);
+  AllocateFrames(buffer_size_);
+}
+
+size_t BufferPool::GetCatalogSize() const { return catalog_buffer_size_; }
+
+size_t BufferPool::GetPartitionCount() const { return partitions_.size(); }
+
+void BufferPool::SetBufferStrategy(BufferStrategyType strategy_type) {
+  std::shared_lock maintenance_lock(maintenance_mutex_);
+  buffer_strategy_type_ = strategy_type;
+  for (auto *partition : GetPartitions(true)) {
+    std::scoped_lock lock(partition->latch_);
+    partition->buffer_strategy_ = CreateBufferStrategy(partition->frame_count_);
+    for (size_t i = 0; i < partition->frame_count_; i++) {
+      const auto &buffer_entry = buffers_[partition->first_frame_ + i];
+      if (buffer_entry.page_id_ != NULL_PAGE_ID) {
+        partition->buffer_strategy_->Access(i);
+        if (buffer_entry.pin_count_ > 0) {
+          partition->buffer_strategy_->SetEvictable(i, false);
+        }
+      }
+    }
+  }
+}
+
+BufferStrategyType BufferPool::GetBufferStrategy() const { return buffer_strategy_type_; }
+
+void BufferPool::SetBackgroundWriterTarget(size_t percent) {
+  if (percent > 100) {
+    throw DbException("Background writer target must be between 0 and 100");
+  }
+  std::scoped_lock lock(worker_control_mutex_);
+  StopBackgroundWriter();
+  bgwriter_target_ = percent;
+  if (bgwriter_target_ > 0) {
+    StartBackgroundWriter();
+  }
+}
+
+size_t BufferPool::GetBackgroundWriterTarget() const { return bgwriter_target_; }
+
+uint32_t BufferPool::GetForegroundWriteCount() const { return foreground_write_count_; }
+
+uint32_t BufferPool::GetBackgroundWriteCount() const { return background_write_count_; }
+
+void BufferPool::SetReadAheadPages(size_t pages) {
+  std::scoped_lock lock(worker_control_mutex_);
+  StopReadAheadWorkers();
+  read_ahead_pages_ = pages;
+  if (pages > 0) {
+    StartReadAheadWorkers();
+  }
+}
+
+size_t BufferPool::GetReadAheadPages() const { return read_ahead_pages_; }
+
+void BufferPool::ReadAhead(oid_t db_oid, oid_t table_oid, pageid_t first_page_id, size_t count,
+                           std::shared_ptr<BufferRing> ring) {
+  if (read_ahead_pages_ == 0 || db_oid == SYSTEM_DATABASE_OID || count == 0) {
+    return;
+  }
+  // 不在缓存中的页面一定已写入文件，超出文件末尾的页面不存在
+  size_t page_count = disk_.GetPageCount(db_oid, table_oid);
+  if (first_page_id >= page_count) {
+    return;
+  }
+  count = std::min<size_t>(count, page_count - first_page_id);
+  {
+    std::scoped_lock lock(read_ahead_mutex_);
+    if (read_ahead_queue_.size() >= MAX_READ_AHEAD_REQUESTS) {
+      return;
+    }
+    read_ahead_queue_.push_back({db_oid, table_oid, first_page_id, count, std::move(ring)});
+  }
+  read_ahead_cv_.notify_one();
+}
+
+uint32_t BufferPool::GetReadAheadCount() const { return read_ahead_count_; }
+
+std::shared_ptr<BufferRing> BufferPool::CreateBulkReadRing(oid_t db_oid, oid_t table_oid) {
+  if (db_oid == SYSTEM_DATABASE_OID) {
+    return nullptr;
+  }
+  // 以文件中的页面数目估计表的大小，尚未写回的新页面不计入
+  size_t page_count = disk_.GetPageCount(db_oid, table_oid);
+  std::shared_lock maintenance_lock(maintenance_mutex_);
+  if (page_count * BULK_ACCESS_FRACTION <= buffer_size_) {
+    return nullptr;
+  }
+  return CreateBufferRing(BUFFER_RING_FRAMES + read_ahead_pages_);
+}
+
+std::shared_ptr<BufferRing> BufferPool::CreateBulkWriteRing() {
+  std::shared_lock maintenance_lock(maintenance_mutex_);
+  return CreateBufferRing(BUFFER_RING_FRAMES);
+}
+
+uint32_t BufferPool::GetRingReuseCount() const { return ring_reuse_count_; }
+
+std::map<oid_t, TableStatistics> BufferPool::GetTableStatistics() {
+  std::shared_lock maintenance_lock(maintenance_mutex_);
+  std::map<oid_t, TableStatistics> statistics(retired_statistics_.begin(), retired_statistics_.end());
+  for (auto *partition : GetPartitions(true)) {
+    std::scoped_lock lock(partition->latch_);
+    for (const auto &[table_oid, partition_statistics] : partition->statistics_) {
+      statistics[table_oid] += partition_statistics;
+    }
+  }
+  for (const auto &[table_oid, disk_statistics] : disk_.GetTableStatistics()) {
+    statistics[table_oid] += disk_statistics;
+  }
+  return statistics;
+}
+
+std::vector<ResidentPage> BufferPool::GetResidentPages() {
+  std::shared_lock maintenance_lock(maintenance_mutex_);
+  std::vector<std::pair<uint64_t, ResidentPage>> entries;
+  for (auto *partition : GetPartitions(false)) {
+    std::scoped_lock lock(partition->latch_);
+    for (const auto &[table_page_id, frame_id] : partition->hashmap_) {
+      const auto &buffer_entry = buffers_[frame_id];
+      entries.push_back(
+          {buffer_entry.last_access_, {buffer_entry.db_oid_, buffer_entry.table_oid_, buffer_entry.page_id_}});
+    }
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+  std::vector<ResidentPage> pages;
+  pages.reserve(entries.size());
+  for (const auto &entry : entries) {
+    pages.push_back(entry.second);
+  }
+  return pages;
+}
+
+void BufferPool::StartPrewarm(std::vector<ResidentPage> pages) {
+  StopPrewarm();
+  prewarm_stop_ = false;
+  prewarm_thread_ = std::thread([this, pages = std::move(pages)]() { PrewarmPages(pages, true); });
+}
+
+void BufferPool::StopPrewarm() {
+  prewarm_stop_ = true;
+  if (prewarm_thread_.joinable()) {
+    prewarm_thread_.join();
+  }
+}
+
+size_t BufferPool::PrewarmTable(oid_t db_oid, oid_t table_oid) {
+  size_t page_count = disk_.GetPageCount(db_oid, table_oid);
+  std::vector<ResidentPage> pages;
+  pages.reserve(page_count);
+  for (size_t page_id = 0; page_id < page_count; page_id++) {
+    pages.push_back({db_oid, table_oid, static_cast<pageid_t>(page_id)});
+  }
+  return PrewarmPages(std::move(pages), false);
+}
+
+uint32_t BufferPool::GetPrewarmCount() const { return prewarm_count_; }
+
+const Disk &BufferPool::GetDisk() const { return disk_; }
+
+size_t BufferPool::GetPageSize() const { return page_size_; }
+
+bool BufferPool::HasDirtyPages(oid_t db_oid, oid_t table_oid) {
+  std::shared_lock maintenance_lock(maintenance_mutex_);
+  for (auto &partition : partitions_) {
+    std::scoped_lock lock(partition->latch_);
+    for (size_t i = 0; i < partition->frame_count_; i++) {
+      const auto &buffer_entry = buffers_[partition->first_frame_ + i];
+      if (buffer_entry.page_id_ != NULL_PAGE_ID && buffer_entry.db_oid_ == db_oid &&
+          buffer_entry.table_oid_ == table_oid && buffer_entry.page_->IsDirty()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void BufferPool::FlushFrames(bool include_catalog) {
+  // 相邻页面通常位于不同分区，锁住所有分区后统一提交写入，使 Disk 能够将其合并为向量化写入
+  // 其他线程不会同时持有多个分区锁，按下标顺序加锁不会死锁
+  auto partitions = GetPartitions(include_catalog);
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(partitions.size());
+  for (auto *partition : partitions) {
+    locks.emplace_back(partition->latch_);
+  }
+  // 先按 WAL 要求刷新各脏页对应的日志，再批量提交所有脏页的写入
+  std::vector<size_t> frames;
+  std::vector<PageIO> pages;
+  for (auto *partition : partitions) {
+    for (size_t i = partition->first_frame_; i < partition->first_frame_ + partition->frame_count_; i++) {
+      auto &buffer_entry = buffers_[i];
+      // 被 pin 住的页面可能正被其他线程修改，保持为脏页，由之后的淘汰或刷盘写回
+      if (buffer_entry.page_id_ == NULL_PAGE_ID || buffer_entry.pin_count_ > 0 || !buffer_entry.page_->IsDirty()) {
+        continue;
+      }
+      auto table_page = std::make_unique<TablePage>(buffer_entry.page_.get());
+      log_manager_.FlushPage(buffer_entry.table_oid_, buffer_entry.page_id_, table_page->GetPageLSN());
+      frames.push_back(i);
+      pages.push_back(
+          {buffer_entry.db_oid_, buffer_entry.table_oid_, buffer_entry.page_id_, buffer_entry.page_->GetData()});
+    }
+  }
+  bool success = true;
+  disk_.WritePages(pages, [&](size_t index, bool page_success) {
+    if (page_success) {
+      auto &buffer_entry = buffers_[frames[index]];
+      buffer_entry.page_->Reset();
+      PartitionStatistics(GetFramePartition(frames[index]), buffer_entry.db_oid_, buffer_entry.table_oid_)
+          .dirty_writes_++;
+    } else {
+      success = false;
+    }
+  });
+  if (!success) {
+    throw DbException("Failed to write back dirty pages in BufferPool::FlushFrames");
+  }
+  locks.clear();
+  ResetFrames(include_catalog);
+}
+
+std::unique_ptr<char, BufferPool::FrameArenaDeleter> BufferPool::AllocateArena(size_t frame_count) const {
+  // aligned_alloc 要求分配大小为对齐大小的整数倍
+  size_t arena_size = (frame_count * page_size_ + FRAME_ALIGNMENT - 1) / FRAME_ALIGNMENT * FRAME_ALIGNMENT;
+  auto *arena = static_cast<char *>(std::aligned_alloc(FRAME_ALIGNMENT, arena_size));
+  if (arena == nullptr) {
+    throw DbException("Failed to allocate " + std::to_string(frame_count) + " buffer frames");
+  }
+  return std::unique_ptr<char, FrameArenaDeleter>(arena);
+}
+
+void BufferPool::AllocateFrames(size_t buffer_size) {
+  arena_ = AllocateArena(buffer_size);
+  buffer_size_ = buffer_size;
+  // 保留系统表页帧，普通表页帧排在其后
+  buffers_.erase(buffers_.begin() + catalog_buffer_size_, buffers_.end());
+  buffers_.reserve(catalog_buffer_size_ + buffer_size);
+  for (size_t i = 0; i < buffer_size; i++) {
+    auto page = std::make_unique<Page>(arena_.get() + i * page_size_, page_size_);
+    buffers_.push_back({INVALID_OID, INVALID_OID, NULL_PAGE_ID, 0, std::move(page)});
+  }
+  io_latches_ = std::make_unique<std::mutex[]>(catalog_buffer_size_ + buffer_size);
+  page_latches_ = std::make_unique<std::shared_mutex[]>(catalog_buffer_size_ + buffer_size);
+  frame_generation_++;
+
+  // 页帧较少时减少分区数目，保证每个分区至少有 MIN_PARTITION_FRAMES 个页帧
+  size_t partition_count = std::clamp<size_t>(buffer_size / MIN_PARTITION_FRAMES, 1, MAX_BUFFER_PARTITIONS);
+  for (auto &partition : partitions_) {
+    RetireStatistics(*partition);
+  }
+  partitions_.clear();
+  for (size_t i = 0; i < partition_count; i++) {
+    auto partition = std::make_unique<BufferPartition>();
+    partition->index_ = i;
+    size_t first_frame = i * buffer_size / partition_count;
+    partition->first_frame_ = catalog_buffer_size_ + first_frame;
+    partition->frame_count_ = (i + 1) * buffer_size / partition_count - first_frame;
+    partition->free_frames_.reserve(partition->frame_count_);
+    partition->hashmap_.reserve(partition->frame_count_);
+    partitions_.push_back(std::move(partition));
+  }
+  ResetFrames(false);
+}
+
+void BufferPool::AllocateCatalogFrames(size_t catalog_buffer_size) {
+  catalog_arena_ = AllocateArena(catalog_buffer_size);
+  catalog_buffer_size_ = catalog_buffer_size;
   buffers_.clear();
-  hashmap_.clear();
-  systable_buffers_.clear();
-  systable_hashmap_.clear();
+  buffers_.reserve(catalog_buffer_size);
+  for (size_t i = 0; i < catalog_buffer_size; i++) {
+    auto page = std::make_unique<Page>(catalog_arena_.get() + i * page_size_, page_size_);
+    buffers_.push_back({INVALID_OID, INVALID_OID, NULL_PAGE_ID, 0, std::move(page)});
+  }
+  if (catalog_partition_ != nullptr) {
+    RetireStatistics(*catalog_partition_);
+  }
+  catalog_partition_ = std::make_unique<BufferPartition>();
+  catalog_partition_->index_ = 0;
+  catalog_partition_->first_frame_ = 0;
+  catalog_partition_->frame_count_ = catalog_buffer_size;
+  catalog_partition_->free_frames_.reserve(catalog_buffer_size);
+  catalog_partition_->hashmap_.reserve(catalog_buffer_size);
+  ResetPartition(*catalog_partition_);
 }
 
-void BufferPool::AddToBuffer(oid_t db_oid, oid_t table_oid, pageid_t page_id, std::shared_ptr<Page> page) {
+void BufferPool::ResetFrames(bool include_catalog) {
+  for (auto *partition : GetPartitions(include_catalog)) {
+    ResetPartition(*partition);
+  }
+}
+
+void BufferPool::ResetPartition(BufferPartition &partition) {
+  std::scoped_lock lock(partition.latch_);
+  partition.free_frames_.clear();
+  partition.buffer_strategy_ = CreateBufferStrategy(partition.frame_count_);
+  // 逆序入栈，使页帧按下标从小到大被使用
+  for (size_t i = partition.first_frame_ + partition.frame_count_; i > partition.first_frame_; i--) {
+    auto &buffer_entry = buffers_[i - 1];
+    if (buffer_entry.pin_count_ > 0) {
+      // 页帧正被其他线程使用，保留其页面和页表项，加入新策略但不可淘汰，解除 pin 后重新可淘汰
+      partition.buffer_strategy_->Access(i - 1 - partition.first_frame_);
+      partition.buffer_strategy_->SetEvictable(i - 1 - partition.first_frame_, false);
+      continue;
+    }
+    if (buffer_entry.page_id_ != NULL_PAGE_ID) {
+      partition.hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
+    }
+    buffer_entry.page_id_ = NULL_PAGE_ID;
+    buffer_entry.page_->Reset();
+    partition.free_frames_.push_back(i - 1);
+  }
+}
+
+std::unique_ptr<BufferStrategy> BufferPool::CreateBufferStrategy(size_t frame_count) const {
+  switch (buffer_strategy_type_) {
+    case BufferStrategyType::LRU:
+      return std::make_unique<LRUBufferStrategy>();
+    case BufferStrategyType::CLOCK:
+      return std::make_unique<ClockBufferStrategy>();
+    case BufferStrategyType::LRU_K:
+      return std::make_unique<LRUKBufferStrategy>();
+    case BufferStrategyType::TWO_QUEUE:
+      return std::make_unique<TwoQueueBufferStrategy>(frame_count);
+    default:
+      throw DbException("Unknown buffer strategy type");
+  }
+}
+
+bool BufferPool::HasPinnedFrames() {
+  for (auto *partition : GetPartitions(true)) {
+    std::scoped_lock lock(partition->latch_);
+    for (size_t i = partition->first_frame_; i < partition->first_frame_ + partition->frame_count_; i++) {
+      if (buffers_[i].pin_count_ > 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::vector<BufferPartition *> BufferPool::GetPartitions(bool include_catalog) {
+  std::vector<BufferPartition *> partitions;
+  partitions.reserve(partitions_.size() + 1);
+  if (include_catalog) {
+    partitions.push_back(catalog_partition_.get());
+  }
+  for (auto &partition : partitions_) {
+    partitions.push_back(partition.get());
+  }
+  return partitions;
+}
+
+BufferPartition &BufferPool::GetPartition(oid_t db_oid, const TablePageid &table_page_id) {
   if (db_oid == SYSTEM_DATABASE_OID) {
-    systable_hashmap_[{table_oid, page_id}] = systable_buffers_.size();
-    systable_buffers_.push_back({db_oid, table_oid, page_id, page});
-  } else {
-    if (buffers_.size() == BUFFER_SIZE) {
-      size_t victim = buffer_strategy_->Evict();
-      FlushPage(victim);
-      buffer_strategy_->Access(victim);
-      buffers_[victim] = {db_oid, table_oid, page_id, page};
-      hashmap_[{table_oid, page_id}] = victim;
+    return *catalog_partition_;
+  }
+  return *partitions_[std::hash<TablePageid>()(table_page_id) % partitions_.size()];
+}
+
+TableStatistics &BufferPool::PartitionStatistics(BufferPartition &partition, oid_t db_oid, oid_t table_oid) {
+  auto &statistics = partition.statistics_[table_oid];
+  statistics.db_oid_ = db_oid;
+  return statistics;
+}
+
+void BufferPool::RetireStatistics(const BufferPartition &partition) {
+  for (const auto &[table_oid, statistics] : partition.statistics_) {
+    retired_statistics_[table_oid] += statistics;
+  }
+}
+
+BufferPartition &BufferPool::GetFramePartition(size_t frame_id) {
+  if (frame_id < catalog_buffer_size_) {
+    return *catalog_partition_;
+  }
+  // 在普通表页帧中，分区 i 的第一个页帧为 i * buffer_size / n，满足该值不超过 offset 的最大 i 即为所属分区
+  size_t offset = frame_id - catalog_buffer_size_;
+  return *partitions_[((offset + 1) * partitions_.size() - 1) / buffer_size_];
+}
+
+size_t BufferPool::FetchFrame(oid_t db_oid, oid_t table_oid, pageid_t page_id, FetchMode mode, BufferRing *ring) {
+  TablePageid table_page_id{table_oid, page_id};
+  auto &partition = GetPartition(db_oid, table_page_id);
+  if (db_oid == SYSTEM_DATABASE_OID || (ring != nullptr && ring->GetFrameGeneration() != frame_generation_)) {
+    // 系统表页面只在系统表分区内替换，不使用页帧环
+    // 页帧环创建后页帧被重新分配时，环中的页帧号和分区已失效，同样不使用页帧环
+    ring = nullptr;
+  }
+  while (true) {
+    std::unique_lock lock(partition.latch_);
+    auto entry = partition.hashmap_.find(table_page_id);
+    if (entry != partition.hashmap_.end()) {
+      if (mode == FetchMode::READ_AHEAD) {
+        return INVALID_FRAME_ID;
+      }
+      size_t frame_id = entry->second;
+      PinFrame(partition, frame_id);
+      partition.buffer_strategy_->Access(frame_id - partition.first_frame_);
+      buffers_[frame_id].last_access_ = access_clock_.fetch_add(1, std::memory_order_relaxed);
+      if (mode == FetchMode::READ) {
+        PartitionStatistics(partition, db_oid, table_oid).hits_++;
+      }
+      lock.unlock();
+      // 等待其他线程对该页帧的读写完成
+      { std::scoped_lock io_lock(io_latches_[frame_id]); }
+      auto &buffer_entry = buffers_[frame_id];
+      if (buffer_entry.table_oid_ != table_oid || buffer_entry.page_id_ != page_id) {
+        // 其他线程读取该页面失败，重新尝试读取
+        lock.lock();
+        UnpinFrame(partition, frame_id);
+        continue;
+      }
+      if (mode == FetchMode::NEW) {
+        memset(buffer_entry.page_->GetData(), 0, page_size_);
+      }
+      return frame_id;
+    }
+
+    PageTableNode node;
+    size_t frame_id = AcquireFrame(partition, lock, node, ring);
+    if (partition.hashmap_.count(table_page_id) > 0) {
+      // 淘汰脏页期间其他线程已将该页面加入缓存，空闲页帧不应由替换策略管理，否则同一页帧可能被分配两次
+      UnpinFrame(partition, frame_id);
+      partition.buffer_strategy_->Remove(frame_id - partition.first_frame_);
+      partition.free_frames_.push_back(frame_id);
+      continue;
+    }
+    auto &buffer_entry = buffers_[frame_id];
+    buffer_entry.db_oid_ = db_oid;
+    buffer_entry.table_oid_ = table_oid;
+    buffer_entry.page_id_ = page_id;
+    buffer_entry.page_->Reset();
+    buffer_entry.last_access_ = access_clock_.fetch_add(1, std::memory_order_relaxed);
+    if (node) {
+      node.key() = table_page_id;
+      node.mapped() = frame_id;
+      partition.hashmap_.insert(std::move(node));
+    } else {
+      partition.hashmap_[table_page_id] = frame_id;
+    }
+    partition.buffer_strategy_->Access(frame_id - partition.first_frame_);
+    if (ring != nullptr) {
+      ring->Push(partition.index_, frame_id, table_page_id);
+    }
+    if (mode == FetchMode::READ) {
+      PartitionStatistics(partition, db_oid, table_oid).misses_++;
+    }
+    // 持有 I/O 锁后释放分区锁，其他线程可以找到该页面，但需等待读取完成
+    std::unique_lock io_lock(io_latches_[frame_id]);
+    lock.unlock();
+
+    if (mode == FetchMode::NEW) {
+      memset(buffer_entry.page_->GetData(), 0, page_size_);
+    } else if (mode == FetchMode::READ_AHEAD) {
+      // 由调用者批量读取页面后调用 CompleteFrameRead
+      io_lock.release();
     } else {
-      buffer_strategy_->Access(buffers_.size());
-      hashmap_[{table_oid, page_id}] = buffers_.size();
-      buffers_.push_back({db_oid, table_oid, page_id, page});
+      try {
+        disk_.ReadPage(db_oid, table_oid, page_id, buffer_entry.page_->GetData());
+      } catch (DbException &) {
+        // 页帧不再对应任何页面，仍由替换策略管理，之后可被淘汰复用
+        lock.lock();
+        partition.hashmap_.erase(table_page_id);
+        buffer_entry.page_id_ = NULL_PAGE_ID;
+        io_lock.unlock();
+        UnpinFrame(partition, frame_id);
+        throw;
+      }
+    }
+    return frame_id;
+  }
+}
+
+size_t BufferPool::AcquireFrame(BufferPartition &partition, std::unique_lock<std::mutex> &lock, PageTableNode &node,
+                                BufferRing *ring) {
+  while (true) {
+    // 页帧环已满时复用环中的页帧，即使分区中仍有空闲页帧，使批量访问只占用环中的页帧
+    size_t frame_id = ring != nullptr ? GetRingVictim(partition, *ring) : INVALID_FRAME_ID;
+    if (frame_id == INVALID_FRAME_ID) {
+      if (!partition.free_frames_.empty()) {
+        frame_id = partition.free_frames_.back();
+        partition.free_frames_.pop_back();
+        PinFrame(partition, frame_id);
+        return frame_id;
+      }
+
+      size_t victim = partition.buffer_strategy_->Evict();
+      if (victim == INVALID_FRAME_ID || victim >= partition.frame_count_ ||
+          buffers_[partition.first_frame_ + victim].pin_count_ > 0) {
+        throw DbException("No evictable frame in buffer pool");
+      }
+      frame_id = partition.first_frame_ + victim;
+    }
+    auto &buffer_entry = buffers_[frame_id];
+    PinFrame(partition, frame_id);
+    if (buffer_entry.page_id_ != NULL_PAGE_ID && buffer_entry.page_->IsDirty()) {
+      // 在分区锁之外写回脏页，期间访问该页面的线程等待写回完成
+      {
+        std::scoped_lock io_lock(io_latches_[frame_id]);
+        lock.unlock();
+        FlushPage(frame_id);
+        foreground_write_count_++;
+      }
+      lock.lock();
+      PartitionStatistics(partition, buffer_entry.db_oid_, buffer_entry.table_oid_).dirty_writes_++;
+      if (buffer_entry.pin_count_ > 1 || buffer_entry.page_->IsDirty()) {
+        // 写回期间页面被其他线程访问，已重新加入替换策略，放弃淘汰该页帧
+        UnpinFrame(partition, frame_id);
+        continue;
+      }
+    }
+    if (buffer_entry.page_id_ != NULL_PAGE_ID) {
+      PartitionStatistics(partition, buffer_entry.db_oid_, buffer_entry.table_oid_).evictions_++;
+      // 复用被淘汰页面的哈希表节点，避免页面替换时分配内存
+      node = partition.hashmap_.extract({buffer_entry.table_oid_, buffer_entry.page_id_});
+      buffer_entry.page_id_ = NULL_PAGE_ID;
     }
+    // 页环中复用的页帧仍在替换策略中，写回期间被访问的页帧也会重新加入替换策略
+    // 将其移出，使调用者对新页面的访问视为首次访问，而不是提升为热点页帧
+    partition.buffer_strategy_->Remove(frame_id - partition.first_frame_);
+    return frame_id;
   }
 }
 
+size_t BufferPool::GetRingVictim(BufferPartition &partition, BufferRing &ring) {
+  TablePageid table_page_id;
+  size_t frame_id = ring.PopVictim(partition.index_, table_page_id);
+  if (frame_id == INVALID_FRAME_ID) {
+    return INVALID_FRAME_ID;
+  }
+  // 页帧可能已被替换策略淘汰并用于其他页面，或正被其他查询使用，此时不复用，由调用者另行获取页帧
+  const auto &buffer_entry = buffers_[frame_id];
+  if (buffer_entry.table_oid_ != table_page_id.table_oid_ || buffer_entry.page_id_ != table_page_id.page_id_ ||
+      buffer_entry.pin_count_ > 0) {
+    return INVALID_FRAME_ID;
+  }
+  ring_reuse_count_++;
+  return frame_id;
+}
+
+void BufferPool::PinFrame(BufferPartition &partition, size_t frame_id) {
+  if (buffers_[frame_id].pin_count_++ == 0) {
+    partition.buffer_strategy_->SetEvictable(frame_id - partition.first_frame_, false);
+  }
+}
+
+void BufferPool::UnpinFrame(BufferPartition &partition, size_t frame_id) {
+  assert(buffers_[frame_id].pin_count_ > 0);
+  if (--buffers_[frame_id].pin_count_ == 0) {
+    partition.buffer_strategy_->SetEvictable(frame_id - partition.first_frame_, true);
+  }
+}
+
+size_t BufferPool::FetchGuardFrame(oid_t db_oid, oid_t table_oid, pageid_t page_id, FetchMode mode, BufferRing *ring,
+                                   bool exclusive) {
+  size_t frame_id;
+  {
+    std::shared_lock maintenance_lock(maintenance_mutex_);
+    frame_id = FetchFrame(db_oid, table_oid, page_id, mode, ring);
+  }
+  // 页帧已被 pin 住，不会被淘汰或重新分配，在维护锁之外等待页面锁，避免阻塞 Flush 和 Resize
+  if (exclusive) {
+    page_latches_[frame_id].lock();
+  } else {
+    page_latches_[frame_id].lock_shared();
+  }
+  return frame_id;
+}
+
+void BufferPool::UnpinFrame(size_t frame_id, bool exclusive) {
+  if (exclusive) {
+    page_latches_[frame_id].unlock();
+  } else {
+    page_latches_[frame_id].unlock_shared();
+  }
+  std::shared_lock maintenance_lock(maintenance_mutex_);
+  auto &partition = GetFramePartition(frame_id);
+  std::scoped_lock lock(partition.latch_);
+  UnpinFrame(partition, frame_id);
+}
+
+void BufferPool::CompleteFrameRead(size_t frame_id, bool success) {
+  auto &partition = GetFramePartition(frame_id);
+  auto &buffer_entry = buffers_[frame_id];
+  std::scoped_lock lock(partition.latch_);
+  if (!success) {
+    // 页帧不再对应任何页面，仍由替换策略管理，之后可被淘汰复用
+    partition.hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
+    buffer_entry.page_id_ = NULL_PAGE_ID;
+  }
+  io_latches_[frame_id].unlock();
+  UnpinFrame(partition, frame_id);
+}
+
 void BufferPool::FlushPage(size_t frame_id) {
-  if (frame_id >= BUFFER_SIZE) {
+  if (frame_id >= buffers_.size()) {
     throw DbException("Invalid frame id in BufferPool::FlushPage");
   }
   auto &buffer_entry = buffers_[frame_id];
   if (buffer_entry.page_->IsDirty()) {
-    auto table_page = std::make_unique<TablePage>(buffer_entry.page_);
+    auto table_page = std::make_unique<TablePage>(buffer_entry.page_.get());
     log_manager_.FlushPage(buffer_entry.table_oid_, buffer_entry.page_id_, table_page->GetPageLSN());
-    assert(buffer_entry.db_oid_ != SYSTEM_DATABASE_OID);
-    disk_.WritePage(Disk::GetFilePath(buffer_entry.db_oid_, buffer_entry.table_oid_), buffer_entry.page_id_,
+    disk_.WritePage(buffer_entry.db_oid_, buffer_entry.table_oid_, buffer_entry.page_id_,
                     buffer_entry.page_->GetData());
+    buffer_entry.page_->Reset();
   }
-  hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
 }
 
-void BufferPool::FlushSysTablePage(size_t frame_id) {
-  auto &buffer_entry = systable_buffers_[frame_id];
-  if (buffer_entry.page_->IsDirty()) {
-    assert(buffer_entry.db_oid_ == SYSTEM_DATABASE_OID);
-    disk_.WritePage(Disk::GetFilePath(buffer_entry.db_oid_, buffer_entry.table_oid_), buffer_entry.page_id_,
-                    buffer_entry.page_->GetData());
+void BufferPool::StartBackgroundWriter() {
+  bgwriter_stop_ = false;
+  bgwriter_ = std::thread(&BufferPool::BackgroundWriterLoop, this);
+}
+
+void BufferPool::StopBackgroundWriter() {
+  if (!bgwriter_.joinable()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(bgwriter_mutex_);
+    bgwriter_stop_ = true;
+  }
+  bgwriter_cv_.notify_all();
+  bgwriter_.join();
+}
+
+void BufferPool::BackgroundWriterLoop() {
+  std::unique_lock lock(bgwriter_mutex_);
+  while (!bgwriter_cv_.wait_for(lock, std::chrono::milliseconds(BGWRITER_INTERVAL_MS),
+                                [this] { return bgwriter_stop_; })) {
+    std::shared_lock maintenance_lock(maintenance_mutex_);
+    for (auto &partition : partitions_) {
+      CleanPartition(*partition);
+    }
+  }
+}
+
+void BufferPool::CleanPartition(BufferPartition &partition) {
+  std::unique_lock lock(partition.latch_);
+  size_t target = (partition.frame_count_ * bgwriter_target_ + 99) / 100;
+  auto candidates = partition.buffer_strategy_->GetEvictionCandidates(target);
+  for (auto candidate : candidates) {
+    size_t frame_id = partition.first_frame_ + candidate;
+    auto &buffer_entry = buffers_[frame_id];
+    // 释放分区锁期间页帧可能已被访问或复用，需重新检查
+    if (buffer_entry.page_id_ == NULL_PAGE_ID || buffer_entry.pin_count_ > 0 || !buffer_entry.page_->IsDirty()) {
+      continue;
+    }
+    // pin 住页帧防止其被淘汰，持有 I/O 锁使其他线程等待写回完成后再访问页面
+    PinFrame(partition, frame_id);
+    {
+      std::scoped_lock io_lock(io_latches_[frame_id]);
+      lock.unlock();
+      FlushPage(frame_id);
+      background_write_count_++;
+    }
+    lock.lock();
+    PartitionStatistics(partition, buffer_entry.db_oid_, buffer_entry.table_oid_).dirty_writes_++;
+    UnpinFrame(partition, frame_id);
+  }
+}
+
+void BufferPool::StartReadAheadWorkers() {
+  read_ahead_stop_ = false;
+  for (size_t i = 0; i < READ_AHEAD_WORKERS; i++) {
+    read_ahead_workers_.emplace_back(&BufferPool::ReadAheadLoop, this);
+  }
+}
+
+void BufferPool::StopReadAheadWorkers() {
+  {
+    std::scoped_lock lock(read_ahead_mutex_);
+    read_ahead_stop_ = true;
+    read_ahead_queue_.clear();
+  }
+  read_ahead_cv_.notify_all();
+  for (auto &worker : read_ahead_workers_) {
+    worker.join();
+  }
+  read_ahead_workers_.clear();
+}
+
+void BufferPool::ReadAheadLoop() {
+  while (true) {
+    ReadAheadRequest request;
+    {
+      std::unique_lock lock(read_ahead_mutex_);
+      read_ahead_cv_.wait(lock, [this] { return read_ahead_stop_ || !read_ahead_queue_.empty(); });
+      if (read_ahead_stop_) {
+        return;
+      }
+      request = read_ahead_queue_.front();
+      read_ahead_queue_.pop_front();
+    }
+    std::shared_lock maintenance_lock(maintenance_mutex_);
+    // 预读期间页帧被 pin 住，每批最多 pin 住 1/8 的页帧，避免前台线程无页帧可用
+    size_t batch_size = std::max<size_t>(1, buffer_size_ / 8);
+    for (size_t offset = 0; offset < request.count_; offset += batch_size) {
+      size_t loaded = 0;
+      bool success = ReadAheadBatch(request.db_oid_, request.table_oid_, request.first_page_id_ + offset,
+                                    std::min(batch_size, request.count_ - offset), request.ring_.get(), loaded);
+      read_ahead_count_ += loaded;
+      if (!success) {
+        break;
+      }
+    }
+  }
+}
+
+bool BufferPool::ReadAheadBatch(oid_t db_oid, oid_t table_oid, pageid_t first_page_id, size_t count,
+                                BufferRing *ring, size_t &loaded) {
+  // 先为不在缓存中的页面分配页帧，再批量提交读取
+  // 持有已分配页帧的 I/O 锁时会获取其他分区锁，这些页帧已被 pin 住，不会被其他线程在持有分区锁时加 I/O 锁，因此不会死锁
+  std::vector<size_t> frames;
+  std::vector<PageIO> pages;
+  bool success = true;
+  for (size_t i = 0; i < count; i++) {
+    if (ring != nullptr && first_page_id + i < ring->GetScanPosition()) {
+      continue;
+    }
+    size_t frame_id;
+    try {
+      frame_id = FetchFrame(db_oid, table_oid, first_page_id + i, FetchMode::READ_AHEAD, ring);
+    } catch (DbException &) {
+      // 预读失败（如页帧均被 pin 住）不影响查询，放弃本次请求余下的页面
+      success = false;
+      break;
+    }
+    if (frame_id != INVALID_FRAME_ID) {
+      frames.push_back(frame_id);
+      pages.push_back(
+          {db_oid, table_oid, first_page_id + static_cast<pageid_t>(i), buffers_[frame_id].page_->GetData()});
+    }
+  }
+  std::vector<bool> completed(frames.size(), false);
+  try {
+    disk_.ReadPages(pages, [&](size_t index, bool page_success) {
+      completed[index] = true;
+      CompleteFrameRead(frames[index], page_success);
+      if (page_success) {
+        loaded++;
+      }
+    });
+  } catch (DbException &) {
+    for (size_t i = 0; i < frames.size(); i++) {
+      if (!completed[i]) {
+        CompleteFrameRead(frames[i], false);
+      }
+    }
+    return false;
+  }
+  return success;
+}
+
+size_t BufferPool::PrewarmPages(std::vector<ResidentPage> pages, bool background) {
+  {
+    std::shared_lock maintenance_lock(maintenance_mutex_);
+    // 缓存容纳不下的页面读入后也会被随后读入的页面淘汰，只保留最近访问的页面
+    if (pages.size() > buffer_size_) {
+      pages.resize(buffer_size_);
+    }
+  }
+  // 按文件和页号排序，同一文件中的连续页面合并为一批读取
+  std::sort(pages.begin(), pages.end(), [](const ResidentPage &a, const ResidentPage &b) {
+    return std::tie(a.db_oid_, a.table_oid_, a.page_id_) < std::tie(b.db_oid_, b.table_oid_, b.page_id_);
+  });
+  size_t prewarmed = 0;
+  size_t i = 0;
+  while (i < pages.size()) {
+    if (background && prewarm_stop_) {
+      break;
+    }
+    const auto &first = pages[i];
+    // 表或数据库可能已被删除，文件也可能在保存页面列表后被截断，跳过文件中不存在的页面
+    size_t page_count = disk_.GetPageCount(first.db_oid_, first.table_oid_);
+    if (first.db_oid_ == SYSTEM_DATABASE_OID || first.page_id_ >= page_count) {
+      i++;
+      continue;
+    }
+    // 每批最多 pin 住 1/8 的页帧，每批之间释放维护锁，不阻塞 Flush 和 Resize
+    std::shared_lock maintenance_lock(maintenance_mutex_);
+    size_t batch_size = std::max<size_t>(1, buffer_size_ / 8);
+    size_t count = 1;
+    while (i + count < pages.size() && count < batch_size && pages[i + count].db_oid_ == first.db_oid_ &&
+           pages[i + count].table_oid_ == first.table_oid_ && pages[i + count].page_id_ == first.page_id_ + count &&
+           pages[i + count].page_id_ < page_count) {
+      count++;
+    }
+    size_t loaded = 0;
+    bool success = ReadAheadBatch(first.db_oid_, first.table_oid_, first.page_id_, count, nullptr, loaded);
+    prewarm_count_ += loaded;
+    if (!success) {
+      break;
+    }
+    prewarmed += count;
+    i += count;
+  }
+  return prewarmed;
+}
+
+std::shared_ptr<BufferRing> BufferPool::CreateBufferRing(size_t capacity) const {
+  if (capacity * BULK_ACCESS_FRACTION > buffer_size_) {
+    return nullptr;
   }
-  systable_hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
+  return std::make_shared<BufferRing>(capacity, partitions_.size(), frame_generation_);
 }
 
 }  // namespace huadb
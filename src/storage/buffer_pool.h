@@ -1,13 +1,25 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/types.h"
 #include "storage/disk.h"
-#include "storage/lru_buffer_strategy.h"
+#include "storage/buffer_ring.h"
+#include "storage/buffer_strategy.h"
+#include "storage/io_statistics.h"
 #include "storage/page.h"
+#include "storage/page_guard.h"
 
 namespace huadb {
 
@@ -15,44 +27,307 @@ struct BufferPoolEntry {
   oid_t db_oid_;
   oid_t table_oid_;
   pageid_t page_id_;
-  std::shared_ptr<Page> page_;
+  size_t pin_count_;  // 页面被 pin 的次数，大于 0 时页面不可淘汰
+  std::unique_ptr<Page> page_;
+  uint64_t last_access_ = 0;  // 页面最近一次被获取时的访问序号，用于按访问顺序导出缓存中的页面
+};
+
+// 缓存中的一个页面，用于保存和恢复缓存内容
+struct ResidentPage {
+  oid_t db_oid_;
+  oid_t table_oid_;
+  pageid_t page_id_;
+};
+
+// buffer pool 的一个分区，页面按 TablePageid 的哈希值分配到分区
+// 分区拥有连续的一段页帧及独立的页表、空闲页帧和替换策略，页面只在所属分区内替换
+// 分区内的页表、空闲页帧、替换策略以及页帧的标识和 pin 次数均由分区锁保护
+struct BufferPartition {
+  std::mutex latch_;
+  // 分区的下标，页帧环按分区记录页帧
+  size_t index_;
+  // 分区第一个页帧的页帧号，替换策略使用分区内的相对页帧号
+  size_t first_frame_;
+  // 分区的页帧数目
+  size_t frame_count_;
+  // 空闲页帧号，按栈的方式使用
+  std::vector<size_t> free_frames_;
+  // page_id 到页帧号的映射
+  std::unordered_map<TablePageid, size_t> hashmap_;
+  // 缓存替换策略
+  std::unique_ptr<BufferStrategy> buffer_strategy_;
+  // 分区中页面所属各表的缓存统计，以表 oid 为键
+  std::unordered_map<oid_t, TableStatistics> statistics_;
 };
 
 class LogManager;
 
+// 线程安全的 buffer pool
+// 系统表页面使用单独的分区，占用固定数目的页帧，既限制了系统表缓存的大小，也避免系统表页面被普通表页面挤出缓存
+// 不同分区的页面访问互不阻塞，磁盘读写在分区锁之外进行，读写期间持有页帧的 I/O 锁，访问该页帧的线程等待其完成
+// 可开启后台写线程，提前写回各分区中即将被淘汰的脏页，减少前台查询淘汰脏页时的同步写
+// 可开启预读，由预读线程异步读入顺序扫描即将访问的页面
+// 大表顺序扫描和批量插入可通过页帧环访问页面，只占用少量页帧
+// 可导出缓存中的页面列表，重启后由预热线程按列表批量读入页面，使缓存尽快恢复到重启前的状态
 class BufferPool {
  public:
-  BufferPool(Disk &disk, LogManager &log_manager);
+  BufferPool(Disk &disk, LogManager &log_manager, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+  ~BufferPool();
 
-  // 获取一个已经存在的页面
-  std::shared_ptr<Page> GetPage(oid_t db_oid, oid_t table_oid, pageid_t page_id);
-  // 新建一个页面
-  std::shared_ptr<Page> NewPage(oid_t db_oid, oid_t table_oid, pageid_t page_id);
-  // 将所有页面刷到磁盘，regular_only 为 true 时只刷普通表页面
+  // 获取一个已经存在的页面用于读取，页面在守卫析构前保持 pin 住
+  // ring 非空时，页面不在缓存中则通过页帧环读入
+  ReadPageGuard FetchPageRead(oid_t db_oid, oid_t table_oid, pageid_t page_id, BufferRing *ring = nullptr);
+  // 获取一个已经存在的页面用于修改，页面在守卫析构前保持 pin 住
+  WritePageGuard FetchPageWrite(oid_t db_oid, oid_t table_oid, pageid_t page_id, BufferRing *ring = nullptr);
+  // 新建一个页面，页面内容清零
+  WritePageGuard NewPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, BufferRing *ring = nullptr);
+  // 将所有页面刷到磁盘并清空缓存，regular_only 为 true 时只刷普通表页面
+  // 被 pin 住的页面正被使用，既不写回也不移出缓存
   void Flush(bool regular_only = false);
   // 清空 buffer pool，不刷脏，用于数据库故障模拟
   void Clear();
+  // 关闭表文件，删除表文件前调用
+  void CloseFile(oid_t db_oid, oid_t table_oid);
+  // 关闭数据库的所有表文件，删除数据库目录前调用
+  void CloseDatabaseFiles(oid_t db_oid);
+  // 将表截断为 page_count 个页面，缓存中被截断的页面直接丢弃，不写回磁盘，有被截断的页面被 pin 住时抛出异常
+  void TruncateFile(oid_t db_oid, oid_t table_oid, size_t page_count);
+  // 页面是否存在，即页面在缓存中或在磁盘上的表文件中
+  bool PageExists(oid_t db_oid, oid_t table_oid, pageid_t page_id);
+
+  // 调整普通表缓存的页帧数目，调整前会将所有普通表页面刷到磁盘，有页面（包括系统表页面）被 pin 住时抛出异常
+  // 分区数目随页帧数目调整，调整期间其他线程获取和释放页面需等待调整完成，之前创建的页帧环不再使用
+  void Resize(size_t buffer_size);
+  // 获取普通表缓存的页帧数目
+  size_t GetSize() const;
+  // 调整系统表缓存的页帧数目，调整前会将所有页面刷到磁盘，有页面被 pin 住时抛出异常
+  // 调整期间其他线程获取和释放页面需等待调整完成
+  void ResizeCatalog(size_t catalog_buffer_size);
+  // 获取系统表缓存的页帧数目
+  size_t GetCatalogSize() const;
+  // 获取页表分区数目
+  size_t GetPartitionCount() const;
+  // 切换缓存替换策略，已在缓存中的页面按页帧号顺序加入新策略，原有的访问历史被丢弃
+  void SetBufferStrategy(BufferStrategyType strategy_type);
+  // 获取缓存替换策略类型
+  BufferStrategyType GetBufferStrategy() const;
+
+  // 设置后台写线程的目标，使每个分区按淘汰顺序排在前 percent% 的页帧保持干净，为 0 时关闭后台写线程
+  // 可由多个连接同时调用，依次停止并重新启动后台写线程
+  void SetBackgroundWriterTarget(size_t percent);
+  // 获取后台写线程的目标
+  size_t GetBackgroundWriterTarget() const;
+  // 前台查询淘汰脏页时同步写回的次数
+  uint32_t GetForegroundWriteCount() const;
+  // 后台写线程写回的次数
+  uint32_t GetBackgroundWriteCount() const;
+
+  // 设置顺序扫描的预读窗口（页面数目），为 0 时关闭预读
+  // 可由多个连接同时调用，依次停止并重新启动预读线程
+  void SetReadAheadPages(size_t pages);
+  // 获取顺序扫描的预读窗口
+  size_t GetReadAheadPages() const;
+  // 异步预读表中从 first_page_id 开始的 count 个页面，超出文件末尾的页面和已在缓存中的页面被跳过
+  // ring 非空时预读的页面通过页帧环读入
+  void ReadAhead(oid_t db_oid, oid_t table_oid, pageid_t first_page_id, size_t count,
+                 std::shared_ptr<BufferRing> ring = nullptr);
+  // 预读线程从磁盘读入的页面数目
+  uint32_t GetReadAheadCount() const;
+
+  // 为顺序扫描创建页帧环，表的页面数目不超过缓存的 1/BULK_ACCESS_FRACTION 或缓存过小时返回空指针
+  // 页帧环除 BUFFER_RING_FRAMES 个页帧外还能容纳一个预读窗口，避免预读的页面在被扫描前就被复用
+  std::shared_ptr<BufferRing> CreateBulkReadRing(oid_t db_oid, oid_t table_oid);
+  // 为批量插入创建页帧环，缓存过小时返回空指针
+  std::shared_ptr<BufferRing> CreateBulkWriteRing();
+  // 通过页帧环复用页帧的次数
+  uint32_t GetRingReuseCount() const;
+  // 各表的缓存与磁盘读写统计，以表 oid 为键，包括已删除的表
+  std::map<oid_t, TableStatistics> GetTableStatistics();
+  // 缓存使用的磁盘，用于获取磁盘读写的延迟统计
+  const Disk &GetDisk() const;
+  // 页面大小，在构造时从磁盘获取，之后不变
+  size_t GetPageSize() const;
+  // 表是否有页面在缓存中被修改且尚未写回磁盘，没有时磁盘上的表文件即为表的最新内容
+  bool HasDirtyPages(oid_t db_oid, oid_t table_oid);
+
+  // 缓存中的普通表页面，按最近访问顺序排列，最近访问的页面在前
+  std::vector<ResidentPage> GetResidentPages();
+  // 启动预热线程，在后台读入 pages 中的页面，pages 按最近访问顺序排列，超出缓存容量的页面被忽略
+  // 已有预热线程在运行时先将其停止
+  void StartPrewarm(std::vector<ResidentPage> pages);
+  // 停止预热线程并等待其退出
+  void StopPrewarm();
+  // 将表的页面读入缓存，至多读入缓存容量个页面，返回预热的页面数目（包括已在缓存中的页面）
+  size_t PrewarmTable(oid_t db_oid, oid_t table_oid);
+  // 预热从磁盘读入的页面数目
+  uint32_t GetPrewarmCount() const;
 
  private:
-  // 将页面加入 buffer pool
-  void AddToBuffer(oid_t db_oid, oid_t table_oid, pageid_t page_id, std::shared_ptr<Page> page);
+  friend class PageGuard;
+
+  struct FrameArenaDeleter {
+    void operator()(char *arena) const { std::free(arena); }
+  };
+
+  using PageTableNode = std::unordered_map<TablePageid, size_t>::node_type;
+
+  // 获取页面的方式
+  enum class FetchMode {
+    READ,        // 读取已存在的页面
+    NEW,         // 新建页面，页面内容清零
+    READ_AHEAD,  // 预读页面，页面已在缓存中时直接返回 INVALID_FRAME_ID；否则不读取页面，返回时仍持有页帧的 I/O 锁
+  };
+
+  struct ReadAheadRequest {
+    oid_t db_oid_;
+    oid_t table_oid_;
+    pageid_t first_page_id_;
+    size_t count_;
+    std::shared_ptr<BufferRing> ring_;
+  };
+
+  // 将所有普通表页面刷到磁盘并置为空闲，include_catalog 为 true 时系统表页面一并处理，调用时需独占 maintenance_mutex_
+  // 被 pin 住的页面被跳过，仍留在缓存中
+  void FlushFrames(bool include_catalog);
+  // 分配按页对齐的页帧内存
+  std::unique_ptr<char, FrameArenaDeleter> AllocateArena(size_t frame_count) const;
+  // 分配普通表页帧内存并划分分区，所有普通表页帧置为空闲，系统表页帧保持不变
+  void AllocateFrames(size_t buffer_size);
+  // 分配系统表页帧内存，所有系统表页帧置为空闲，之后需调用 AllocateFrames 重新分配普通表页帧
+  void AllocateCatalogFrames(size_t catalog_buffer_size);
+  // 将所有普通表页帧置为空闲，include_catalog 为 true 时系统表页帧一并处理
+  void ResetFrames(bool include_catalog);
+  // 将分区中未被 pin 住的页帧置为空闲，并重建缓存替换策略，被 pin 住的页帧保留其页面
+  void ResetPartition(BufferPartition &partition);
+  // 根据策略类型为分区创建缓存替换策略
+  std::unique_ptr<BufferStrategy> CreateBufferStrategy(size_t frame_count) const;
+  // 判断系统表分区和普通表分区中是否有被 pin 住的页帧，调用时需独占 maintenance_mutex_
+  bool HasPinnedFrames();
+  // 普通表分区，include_catalog 为 true 时包括系统表分区
+  std::vector<BufferPartition *> GetPartitions(bool include_catalog);
+  // 页面所属的分区，系统表页面属于系统表分区
+  BufferPartition &GetPartition(oid_t db_oid, const TablePageid &table_page_id);
+  // 分区中表的缓存统计，调用时需持有分区锁
+  TableStatistics &PartitionStatistics(BufferPartition &partition, oid_t db_oid, oid_t table_oid);
+  // 分区被重新分配前保留其统计，调用时不应有其他线程访问 buffer pool
+  void RetireStatistics(const BufferPartition &partition);
+  // 页帧所属的分区
+  BufferPartition &GetFramePartition(size_t frame_id);
+  // 获取页面守卫所需的页帧：持有维护锁获取页面并将其 pin 住，之后获取页帧的页面锁，exclusive 为 true 时独占获取
+  size_t FetchGuardFrame(oid_t db_oid, oid_t table_oid, pageid_t page_id, FetchMode mode, BufferRing *ring,
+                         bool exclusive);
+  // 获取普通表页面并将其 pin 住，返回页帧号，调用时需共享持有 maintenance_mutex_
+  size_t FetchFrame(oid_t db_oid, oid_t table_oid, pageid_t page_id, FetchMode mode, BufferRing *ring);
+  // 在分区中获取一个空闲或淘汰的页帧并将其 pin 住，页帧不再对应任何页面，调用时需持有分区锁
+  // 淘汰脏页时会暂时释放分区锁进行写回，被淘汰页面的页表节点通过 node 返回以便复用
+  // ring 非空时优先复用页帧环中的页帧
+  size_t AcquireFrame(BufferPartition &partition, std::unique_lock<std::mutex> &lock, PageTableNode &node,
+                      BufferRing *ring);
+  // 从页帧环中取出分区可复用的页帧，页帧仍对应环读入的页面且未被 pin 住时才可复用，否则返回 INVALID_FRAME_ID
+  // 调用时需持有分区锁
+  size_t GetRingVictim(BufferPartition &partition, BufferRing &ring);
+  // pin 住页帧，使其不可淘汰，调用时需持有分区锁
+  void PinFrame(BufferPartition &partition, size_t frame_id);
+  // 解除页帧的 pin，pin 次数降为 0 时页帧重新可淘汰，调用时需持有分区锁
+  void UnpinFrame(BufferPartition &partition, size_t frame_id);
+  // 释放页帧的页面锁并解除 pin，exclusive 表示页面锁是否被独占持有，供页面守卫调用
+  void UnpinFrame(size_t frame_id, bool exclusive);
+  // 完成 READ_AHEAD 方式获取的页帧的读取，读取失败时移除页面，之后释放页帧的 I/O 锁并解除 pin
+  void CompleteFrameRead(size_t frame_id, bool success);
   // 将 buffer 中对应的页面刷到磁盘
   void FlushPage(size_t frame_id);
-  // 将 systable_buffer 中对应的页面刷到磁盘
-  void FlushSysTablePage(size_t frame_id);
+
+  // 启动后台写线程
+  void StartBackgroundWriter();
+  // 停止后台写线程并等待其退出
+  void StopBackgroundWriter();
+  // 后台写线程主循环，每隔 BGWRITER_INTERVAL_MS 毫秒清理一次所有分区
+  void BackgroundWriterLoop();
+  // 写回分区中即将被淘汰的脏页
+  void CleanPartition(BufferPartition &partition);
+
+  // 启动预读线程
+  void StartReadAheadWorkers();
+  // 停止预读线程并丢弃未处理的预读请求
+  void StopReadAheadWorkers();
+  // 预读线程主循环，依次处理预读请求
+  void ReadAheadLoop();
+  // 批量预读一批连续页面，loaded 为从磁盘读入的页面数目，预读失败时返回 false
+  bool ReadAheadBatch(oid_t db_oid, oid_t table_oid, pageid_t first_page_id, size_t count, BufferRing *ring,
+                      size_t &loaded);
+  // 按文件和页号顺序批量读入 pages 中的页面，background 为 true 时由预热线程调用，可被 StopPrewarm 中止
+  // 返回预热的页面数目
+  size_t PrewarmPages(std::vector<ResidentPage> pages, bool background);
+  // 创建容纳 capacity 个页帧的页帧环，缓存过小时返回空指针，调用时需共享持有 maintenance_mutex_
+  std::shared_ptr<BufferRing> CreateBufferRing(size_t capacity) const;
 
   Disk &disk_;
   LogManager &log_manager_;
-  std::unique_ptr<BufferStrategy> buffer_strategy_;  // 缓存替换策略
+  size_t page_size_;
+  BufferStrategyType buffer_strategy_type_ = BufferStrategyType::LRU;  // 缓存替换策略类型
 
-  // 普通表缓存
+  // 普通表页帧数目
+  size_t buffer_size_;
+  // 系统表页帧数目，系统表页帧的页帧号为 [0, catalog_buffer_size_)，普通表页帧排在其后
+  size_t catalog_buffer_size_;
+  // 页帧内存，一块按页对齐的连续内存，页面淘汰后页帧被直接复用
+  // 调整普通表缓存大小时系统表页帧不受影响，因此分别分配
+  std::unique_ptr<char, FrameArenaDeleter> arena_;
+  std::unique_ptr<char, FrameArenaDeleter> catalog_arena_;
+  // 下标为页帧号，page_id_ 为 NULL_PAGE_ID 表示页帧不对应任何页面
   std::vector<BufferPoolEntry> buffers_;
-  // page_id 到 buffers_ 下标的映射
-  std::unordered_map<TablePageid, size_t> hashmap_;
-  // 系统表专用缓存
-  std::vector<BufferPoolEntry> systable_buffers_;
-  // 系统表专用映射
-  std::unordered_map<TablePageid, size_t> systable_hashmap_;
+  // 页帧的 I/O 锁，页帧读写磁盘期间被持有
+  std::unique_ptr<std::mutex[]> io_latches_;
+  // 页帧的页面锁，页面守卫持有期间被持有，只读守卫共享持有，读写守卫独占持有
+  // 页面锁只在页帧被 pin 住后获取，在解除 pin 前释放，未被 pin 住的页帧的页面锁不被任何线程持有
+  std::unique_ptr<std::shared_mutex[]> page_latches_;
+  // 普通表页表分区
+  std::vector<std::unique_ptr<BufferPartition>> partitions_;
+  // 系统表分区
+  std::unique_ptr<BufferPartition> catalog_partition_;
+
+  // 前台获取和释放页面、后台任务（后台写、预读）操作页帧期间共享持有
+  // Flush、Clear、Resize 独占持有，避免与其他线程同时操作页帧，重新分配页帧期间其他线程不会访问页帧和分区
+  std::shared_mutex maintenance_mutex_;
+  // 页帧被重新分配的次数，用于判断页帧环是否在重新分配前创建
+  size_t frame_generation_ = 0;
+
+  // 串行化后台写线程和预读线程的停止和重新启动，避免多个连接同时设置时重复 join 或覆盖仍在运行的线程
+  std::mutex worker_control_mutex_;
+  // 后台写线程
+  std::thread bgwriter_;
+  // 用于唤醒和停止后台写线程
+  std::mutex bgwriter_mutex_;
+  std::condition_variable bgwriter_cv_;
+  bool bgwriter_stop_ = false;
+  // 每个分区需保持干净的页帧比例（百分比）
+  size_t bgwriter_target_ = 0;
+  std::atomic<uint32_t> foreground_write_count_ = 0;
+  std::atomic<uint32_t> background_write_count_ = 0;
+
+  // 预读线程
+  std::vector<std::thread> read_ahead_workers_;
+  // 保护预读请求队列
+  std::mutex read_ahead_mutex_;
+  std::condition_variable read_ahead_cv_;
+  std::deque<ReadAheadRequest> read_ahead_queue_;
+  bool read_ahead_stop_ = false;
+  // 预读窗口
+  std::atomic<size_t> read_ahead_pages_ = 0;
+  std::atomic<uint32_t> read_ahead_count_ = 0;
+
+  // 通过页帧环复用页帧的次数
+  std::atomic<uint32_t> ring_reuse_count_ = 0;
+
+  // 页面访问序号，每次获取页面时递增
+  std::atomic<uint64_t> access_clock_ = 0;
+  // 预热线程
+  std::thread prewarm_thread_;
+  std::atomic<bool> prewarm_stop_ = false;
+  std::atomic<uint32_t> prewarm_count_ = 0;
+
+  // 调整缓存大小时被重新分配的分区的统计
+  std::unordered_map<oid_t, TableStatistics> retired_statistics_;
 };
 
 }  // namespace huadb
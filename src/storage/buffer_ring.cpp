@@ -0,0 +1,39 @@
+#include "storage/buffer_ring.h"
+
+#include "common/constants.h"
+
+namespace huadb {
+
+BufferRing::BufferRing(size_t capacity, size_t partition_count, size_t frame_generation)
+    : partition_capacity_((capacity + partition_count - 1) / partition_count),
+      partitions_(partition_count),
+      frame_generation_(frame_generation) {}
+
+size_t BufferRing::PopVictim(size_t partition_index, TablePageid &table_page_id) {
+  std::scoped_lock lock(latch_);
+  auto &entries = partitions_[partition_index];
+  if (entries.size() < partition_capacity_) {
+    return INVALID_FRAME_ID;
+  }
+  auto entry = entries.front();
+  entries.pop_front();
+  table_page_id = entry.table_page_id_;
+  return entry.frame_id_;
+}
+
+void BufferRing::Push(size_t partition_index, size_t frame_id, const TablePageid &table_page_id) {
+  std::scoped_lock lock(latch_);
+  auto &entries = partitions_[partition_index];
+  if (entries.size() >= partition_capacity_) {
+    entries.pop_front();
+  }
+  entries.push_back({frame_id, table_page_id});
+}
+
+void BufferRing::SetScanPosition(pageid_t page_id) { scan_position_ = page_id; }
+
+pageid_t BufferRing::GetScanPosition() const { return scan_position_; }
+
+size_t BufferRing::GetFrameGeneration() const { return frame_generation_; }
+
+}  // namespace huadb
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "common/types.h"
+
+namespace huadb {
+
+// 页帧环，用于大表顺序扫描、ANALYZE 和批量插入等批量访问
+// 通过页帧环读入页面时，若页面所属分区在环中的页帧已满，则复用其中最早读入且已不再使用的页帧，
+// 而不按替换策略淘汰其他页面，使一次批量访问只占用少量页帧，不会冲掉其他查询的热点页面
+// 页帧环只在一条语句内使用，扫描线程和预读线程可以同时使用
+class BufferRing {
+ public:
+  // capacity 为环的页帧数目，平均分配到 buffer pool 的 partition_count 个分区
+  // frame_generation 为创建时 buffer pool 页帧被重新分配的次数，之后页帧被重新分配时环不再被使用
+  BufferRing(size_t capacity, size_t partition_count, size_t frame_generation);
+
+  // 分区在环中的页帧已满时，取出其中最早加入的页帧号及加入时页帧对应的页面，否则返回 INVALID_FRAME_ID
+  // 取出的页帧可能已被淘汰并用于其他页面，由调用者检查后决定是否复用
+  size_t PopVictim(size_t partition_index, TablePageid &table_page_id);
+  // 将通过环读入页面的页帧加入环
+  void Push(size_t partition_index, size_t frame_id, const TablePageid &table_page_id);
+
+  // 使用页帧环的顺序扫描当前访问的页面号
+  // 预读落后于扫描时跳过扫描已越过的页面，否则这些页面会占用环中的页帧并挤掉即将访问的页面
+  void SetScanPosition(pageid_t page_id);
+  pageid_t GetScanPosition() const;
+  size_t GetFrameGeneration() const;
+
+ private:
+  struct RingEntry {
+    size_t frame_id_;
+    TablePageid table_page_id_;
+  };
+
+  std::mutex latch_;           // 保护 partitions_
+  size_t partition_capacity_;  // 每个分区在环中的最大页帧数目
+  // 各分区在环中的页帧，按加入顺序排列
+  std::vector<std::deque<RingEntry>> partitions_;
+  std::atomic<pageid_t> scan_position_ = 0;
+  size_t frame_generation_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,18 @@
+#include "storage/buffer_strategy.h"
+
+namespace huadb {
+
+std::vector<size_t> BufferStrategy::GetEvictionCandidates(size_t /*count*/) const { return {}; }
+
+void BufferStrategy::SetEvictable(size_t frame_no, bool evictable) {
+  if (frame_no >= evictable_.size()) {
+    evictable_.resize(frame_no + 1, true);
+  }
+  evictable_[frame_no] = evictable;
+}
+
+bool BufferStrategy::IsEvictable(size_t frame_no) const {
+  return frame_no >= evictable_.size() || evictable_[frame_no];
+}
+
+}  // namespace huadb
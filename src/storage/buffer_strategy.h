@@ -1,17 +1,34 @@
 #pragma once
 
 #include <cstddef>
+#include <vector>
 
 namespace huadb {
 
+// 缓存替换策略类型
+enum class BufferStrategyType { LRU, CLOCK, LRU_K, TWO_QUEUE };
+
 // 缓存替换策略的模板类
 class BufferStrategy {
  public:
   virtual ~BufferStrategy() = default;
   // 页面访问接口
   virtual void Access(size_t frame_no) = 0;
-  // 页面替换接口
+  // 页面替换接口，需跳过不可淘汰的页帧，没有可淘汰的页帧时返回 INVALID_FRAME_ID
   virtual size_t Evict() = 0;
+  // 将页帧移出替换策略，之后再次访问该页帧时视为首次访问，页帧不在替换策略中时不做修改
+  virtual void Remove(size_t frame_no) = 0;
+  // 按淘汰顺序返回至多 count 个可淘汰的页帧，不改变替换策略的状态
+  // 后台写线程据此提前写回即将被淘汰的脏页，默认返回空，即后台写线程不清理页帧
+  virtual std::vector<size_t> GetEvictionCandidates(size_t count) const;
+
+  // 设置页帧是否可淘汰，被 pin 住的页帧不可淘汰
+  void SetEvictable(size_t frame_no, bool evictable);
+  // 判断页帧是否可淘汰
+  bool IsEvictable(size_t frame_no) const;
+
+ private:
+  std::vector<bool> evictable_;
 };
 
 }  // namespace huadb
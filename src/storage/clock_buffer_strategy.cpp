@@ -0,0 +1,61 @@
+#include "storage/clock_buffer_strategy.h"
+
+#include "common/constants.h"
+
+namespace huadb {
+
+void ClockBufferStrategy::Access(size_t frame_no) {
+  if (frame_no >= present_.size()) {
+    present_.resize(frame_no + 1, false);
+    referenced_.resize(frame_no + 1, false);
+  }
+  present_[frame_no] = true;
+  referenced_[frame_no] = true;
+}
+
+size_t ClockBufferStrategy::Evict() {
+  size_t size = present_.size();
+  if (size == 0) {
+    return INVALID_FRAME_ID;
+  }
+  // 第一圈清除引用位，第二圈必能找到引用位为 0 的可淘汰页帧
+  for (size_t i = 0; i < 2 * size; i++) {
+    size_t frame_no = hand_;
+    hand_ = (hand_ + 1) % size;
+    if (!present_[frame_no] || !IsEvictable(frame_no)) {
+      continue;
+    }
+    if (referenced_[frame_no]) {
+      referenced_[frame_no] = false;
+      continue;
+    }
+    present_[frame_no] = false;
+    return frame_no;
+  }
+  return INVALID_FRAME_ID;
+}
+
+void ClockBufferStrategy::Remove(size_t frame_no) {
+  if (frame_no >= present_.size()) {
+    return;
+  }
+  present_[frame_no] = false;
+  referenced_[frame_no] = false;
+}
+
+std::vector<size_t> ClockBufferStrategy::GetEvictionCandidates(size_t count) const {
+  // 时钟指针第一圈淘汰引用位为 0 的页帧，第二圈淘汰其余页帧
+  std::vector<size_t> candidates;
+  size_t size = present_.size();
+  for (bool referenced : {false, true}) {
+    for (size_t i = 0; i < size && candidates.size() < count; i++) {
+      size_t frame_no = (hand_ + i) % size;
+      if (present_[frame_no] && IsEvictable(frame_no) && referenced_[frame_no] == referenced) {
+        candidates.push_back(frame_no);
+      }
+    }
+  }
+  return candidates;
+}
+
+}  // namespace huadb
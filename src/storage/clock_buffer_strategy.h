@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include "storage/buffer_strategy.h"
+
+namespace huadb {
+
+// CLOCK 替换策略，页帧组成环形队列，访问时设置引用位
+// 淘汰时指针循环扫描，清除引用位，淘汰第一个引用位为 0 的可淘汰页帧
+class ClockBufferStrategy : public BufferStrategy {
+ public:
+  void Access(size_t frame_no) override;
+  size_t Evict() override;
+  void Remove(size_t frame_no) override;
+  std::vector<size_t> GetEvictionCandidates(size_t count) const override;
+
+ private:
+  // 页帧是否在缓存中
+  std::vector<bool> present_;
+  // 页帧的引用位
+  std::vector<bool> referenced_;
+  // 时钟指针
+  size_t hand_ = 0;
+};
+
+}  // namespace huadb
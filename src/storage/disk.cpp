@@ -1,15 +1,27 @@
 #include "storage/disk.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <numeric>
+#include <tuple>
 
 #include "common/constants.h"
 #include "common/exceptions.h"
-#include "common/string_util.h"
 
 namespace huadb {
 
-Disk::Disk() {
+Disk::Disk(IOEngineType io_engine_type, bool direct_io)
+    : request_direct_io_(direct_io),
+      direct_io_(direct_io && page_size_ % DIRECT_IO_ALIGNMENT == 0),
+      io_engine_(IOEngine::Create(io_engine_type)) {
   if (!DirectoryExists(BASE_PATH)) {
     CreateDirectory(BASE_PATH);
   }
@@ -26,13 +38,19 @@ Disk::Disk() {
     }
     log_segments = log_file_size / LOG_SEGMENT_SIZE;
   }
-  log_fs_.open(LOG_NAME, std::fstream::in | std::fstream::out | std::fstream::binary);
-  if (log_fs_.fail()) {
-    throw DbException("fstream failed in Disk::Disk");
+  log_fd_ = open(LOG_NAME, O_RDWR);
+  if (log_fd_ < 0) {
+    throw DbException(std::string("open log file failed in Disk::Disk: ") + strerror(errno));
   }
 }
 
-Disk::~Disk() { ChangeDirectory(".."); }
+Disk::~Disk() {
+  for (const auto &[key, fd] : fds_) {
+    close(fd);
+  }
+  close(log_fd_);
+  ChangeDirectory("..");
+}
 
 bool Disk::DirectoryExists(const std::string &path) { return std::filesystem::is_directory(path); }
 
@@ -60,87 +78,312 @@ void Disk::CreateFile(const std::string &path) { std::ofstream ofs(path); }
 
 void Disk::RemoveFile(const std::string &path) { std::filesystem::remove(path); }
 
-void Disk::OpenFile(const std::string &path) {
-  hashmap_[path] = std::fstream(path, std::fstream::in | std::fstream::out | std::fstream::binary);
-  if (!hashmap_[path]) {
-    throw DbException("file " + path + " does not exist");
+void Disk::SetPageSize(size_t page_size) {
+  if (page_size < MIN_PAGE_SIZE || page_size > MAX_PAGE_SIZE || (page_size & (page_size - 1)) != 0) {
+    throw DbException("Invalid page size " + std::to_string(page_size) + ", must be a power of 2 between " +
+                      std::to_string(MIN_PAGE_SIZE) + " and " + std::to_string(MAX_PAGE_SIZE));
+  }
+  std::unique_lock lock(files_latch_);
+  if (!fds_.empty() && page_size != page_size_) {
+    throw DbException("Cannot change page size after table files are opened");
   }
+  page_size_ = page_size;
+  direct_io_ = request_direct_io_ && page_size_ % DIRECT_IO_ALIGNMENT == 0;
 }
 
-void Disk::CloseFile(const std::string &path) { hashmap_.erase(path); }
+size_t Disk::GetPageSize() const { return page_size_; }
 
-void Disk::ReadPage(const std::string &path, pageid_t page_id, char *data) {
-  if (GetOid(path).first != SYSTEM_DATABASE_OID) {
-    access_count_++;
+size_t Disk::GetPageCount(oid_t db_oid, oid_t table_oid) const {
+  // 预读和 PageExists 等频繁调用，使用 fstat 而不每次构造路径并按路径查找文件
+  std::shared_lock lock(files_latch_);
+  int fd = GetFd(lock, db_oid, table_oid);
+  struct stat file_stat;
+  if (fd < 0 || fstat(fd, &file_stat) != 0) {
+    return 0;
   }
-  if (hashmap_.count(path) == 0) {
-    OpenFile(path);
+  return file_stat.st_size / page_size_;
+}
+
+void Disk::TruncateFile(oid_t db_oid, oid_t table_oid, size_t page_count) {
+  if (GetPageCount(db_oid, table_oid) > page_count) {
+    std::filesystem::resize_file(GetFilePath(db_oid, table_oid), page_count * page_size_);
+    std::scoped_lock lock(extents_mutex_);
+    allocated_pages_.erase(GetFileKey(db_oid, table_oid));
   }
-  auto &fs = hashmap_[path];
-  if (fs.fail()) {
-    throw DbException("fstream failed in Disk::ReadPage");
+}
+
+void Disk::CloseFile(oid_t db_oid, oid_t table_oid) {
+  std::unique_lock lock(files_latch_);
+  auto entry = fds_.find(GetFileKey(db_oid, table_oid));
+  if (entry != fds_.end()) {
+    close(entry->second);
+    fds_.erase(entry);
+  }
+  std::scoped_lock extents_lock(extents_mutex_);
+  allocated_pages_.erase(GetFileKey(db_oid, table_oid));
+}
+
+void Disk::CloseDatabaseFiles(oid_t db_oid) {
+  std::unique_lock lock(files_latch_);
+  for (auto entry = fds_.begin(); entry != fds_.end();) {
+    if (entry->first >> 32 == db_oid) {
+      close(entry->second);
+      entry = fds_.erase(entry);
+    } else {
+      entry++;
+    }
   }
-  fs.seekg(page_id * DB_PAGE_SIZE);
-  fs.read(data, DB_PAGE_SIZE);
-  if (fs.gcount() != DB_PAGE_SIZE) {
-    throw DbException(path + " read page " + std::to_string(page_id) + " failed: read " + std::to_string(fs.gcount()) +
-                      " bytes, expected " + std::to_string(DB_PAGE_SIZE) + " bytes");
+  std::scoped_lock extents_lock(extents_mutex_);
+  for (auto entry = allocated_pages_.begin(); entry != allocated_pages_.end();) {
+    entry = entry->first >> 32 == db_oid ? allocated_pages_.erase(entry) : std::next(entry);
   }
 }
 
-void Disk::WritePage(const std::string &path, pageid_t page_id, const char *data) {
-  if (!FileExists(path)) {
-    return;
+void Disk::ReadPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, char *data) {
+  if (db_oid != SYSTEM_DATABASE_OID) {
+    access_count_++;
   }
-  if (hashmap_.count(path) == 0) {
-    OpenFile(path);
+  std::shared_lock lock(files_latch_);
+  int fd = GetFd(lock, db_oid, table_oid);
+  if (fd < 0) {
+    throw DbException("file " + GetFilePath(db_oid, table_oid) + " does not exist");
   }
-  if (GetOid(path).first != SYSTEM_DATABASE_OID) {
+  auto start = std::chrono::steady_clock::now();
+  if (!SyncIOEngine::ExecuteRequest({IOOpcode::READ, fd, data, page_size_, uint64_t{page_id} * page_size_})) {
+    throw DbException(GetFilePath(db_oid, table_oid) + " read page " + std::to_string(page_id) + " failed");
+  }
+  RecordPageIO(db_oid, table_oid, IOOpcode::READ, start);
+}
+
+void Disk::WritePage(oid_t db_oid, oid_t table_oid, pageid_t page_id, const char *data) {
+  std::shared_lock lock(files_latch_);
+  int fd = GetFd(lock, db_oid, table_oid);
+  // 表已被删除
+  if (fd < 0) {
+    return;
+  }
+  if (db_oid != SYSTEM_DATABASE_OID) {
     access_count_++;
   }
-  auto &fs = hashmap_[path];
-  if (fs.fail()) {
-    throw DbException("fstream failed in Disk::WritePage");
+  Preallocate(fd, db_oid, table_oid, page_id);
+  // I/O 引擎只读取写请求的数据，不会修改
+  auto start = std::chrono::steady_clock::now();
+  if (!SyncIOEngine::ExecuteRequest(
+          {IOOpcode::WRITE, fd, const_cast<char *>(data), page_size_, uint64_t{page_id} * page_size_})) {
+    throw DbException(GetFilePath(db_oid, table_oid) + " write page " + std::to_string(page_id) +
+                      " failed: " + strerror(errno));
+  }
+  RecordPageIO(db_oid, table_oid, IOOpcode::WRITE, start);
+}
+
+void Disk::ReadPages(const std::vector<PageIO> &pages, const IOCallback &callback) {
+  std::vector<IORequest> requests;
+  std::vector<size_t> indexes;
+  requests.reserve(pages.size());
+  indexes.reserve(pages.size());
+  std::shared_lock lock(files_latch_);
+  for (size_t i = 0; i < pages.size(); i++) {
+    const auto &page = pages[i];
+    if (page.db_oid_ != SYSTEM_DATABASE_OID) {
+      access_count_++;
+    }
+    int fd = GetFd(lock, page.db_oid_, page.table_oid_);
+    if (fd < 0) {
+      callback(i, false);
+      continue;
+    }
+    requests.push_back({IOOpcode::READ, fd, page.data_, page_size_, uint64_t{page.page_id_} * page_size_});
+    indexes.push_back(i);
   }
-  fs.seekp(page_id * DB_PAGE_SIZE);
-  fs.write(data, DB_PAGE_SIZE);
-  fs.flush();
+  auto start = std::chrono::steady_clock::now();
+  io_engine_->Execute(requests, [&](size_t index, bool success) {
+    if (success) {
+      const auto &page = pages[indexes[index]];
+      RecordPageIO(page.db_oid_, page.table_oid_, IOOpcode::READ, start);
+    }
+    callback(indexes[index], success);
+  });
+}
+
+void Disk::WritePages(const std::vector<PageIO> &pages, const IOCallback &callback) {
+  // 按 (数据库, 表, 页面) 排序，同一文件中连续的页面合并为一次向量化写入
+  std::vector<size_t> order(pages.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return std::tie(pages[a].db_oid_, pages[a].table_oid_, pages[a].page_id_) <
+           std::tie(pages[b].db_oid_, pages[b].table_oid_, pages[b].page_id_);
+  });
+  std::vector<IORequest> requests;
+  std::vector<std::vector<size_t>> runs;  // 每个请求包含的页面下标
+  std::shared_lock lock(files_latch_);
+  for (size_t i : order) {
+    const auto &page = pages[i];
+    int fd = GetFd(lock, page.db_oid_, page.table_oid_);
+    if (fd < 0) {
+      callback(i, true);
+      continue;
+    }
+    if (page.db_oid_ != SYSTEM_DATABASE_OID) {
+      access_count_++;
+    }
+    Preallocate(fd, page.db_oid_, page.table_oid_, page.page_id_);
+    uint64_t offset = uint64_t{page.page_id_} * page_size_;
+    if (!requests.empty()) {
+      auto &request = requests.back();
+      if (request.fd_ == fd && request.offset_ + request.size_ == offset && runs.back().size() < MAX_COALESCED_PAGES) {
+        if (request.iovecs_.empty()) {
+          request.iovecs_.push_back({request.data_, request.size_});
+        }
+        request.iovecs_.push_back({page.data_, page_size_});
+        request.size_ += page_size_;
+        runs.back().push_back(i);
+        continue;
+      }
+    }
+    requests.push_back({IOOpcode::WRITE, fd, page.data_, page_size_, offset});
+    runs.push_back({i});
+  }
+  auto start = std::chrono::steady_clock::now();
+  io_engine_->Execute(requests, [&](size_t index, bool success) {
+    for (size_t i : runs[index]) {
+      if (success) {
+        RecordPageIO(pages[i].db_oid_, pages[i].table_oid_, IOOpcode::WRITE, start);
+      }
+      callback(i, success);
+    }
+  });
 }
 
 void Disk::ReadLog(uint32_t offset, uint32_t count, char *data) {
-  if (log_fs_.fail()) {
-    throw DbException("fstream failed in Disk::ReadLog");
+  if (!SyncIOEngine::ExecuteRequest({IOOpcode::READ, log_fd_, data, count, offset})) {
+    throw DbException("read log failed (offset: " + std::to_string(offset) + ", count: " + std::to_string(count) + ")");
+  }
+}
+
+void Disk::WriteLog(uint32_t offset, uint32_t count, const char *data) { WriteLogs({{offset, count, data}}); }
+
+void Disk::WriteLogs(const std::vector<LogIO> &logs) {
+  std::vector<IORequest> requests;
+  requests.reserve(logs.size());
+  size_t end = 0;
+  for (const auto &log : logs) {
+    // I/O 引擎只读取写请求的数据，不会修改
+    requests.push_back({IOOpcode::WRITE, log_fd_, const_cast<char *>(log.data_), log.count_, log.offset_});
+    end = std::max<size_t>(end, log.offset_ + log.count_);
   }
-  log_fs_.seekg(offset);
-  log_fs_.read(data, count);
-  if (log_fs_.gcount() != count) {
-    throw DbException("read log failed (offset: " + std::to_string(offset) + ", count: " + std::to_string(count) +
-                      ", read: " + std::to_string(log_fs_.gcount()) + ")");
+  ExtendLog(end);
+  bool success = true;
+  auto start = std::chrono::steady_clock::now();
+  io_engine_->Execute(requests, [&](size_t, bool request_success) {
+    success = success && request_success;
+    log_write_latency_.Record(std::chrono::steady_clock::now() - start);
+  });
+  if (!success) {
+    throw DbException("write log failed");
   }
 }
 
-void Disk::WriteLog(uint32_t offset, uint32_t count, const char *data) {
-  if (log_fs_.fail()) {
-    throw DbException("fstream failed in Disk::WriteLog");
+IOEngineType Disk::GetIOEngineType() const { return io_engine_->GetType(); }
+
+bool Disk::IsDirectIO() const { return direct_io_; }
+
+uint64_t Disk::GetAccessCount() const { return access_count_; }
+
+uint64_t Disk::GetExtendCount() const { return extend_count_; }
+
+std::unordered_map<oid_t, TableStatistics> Disk::GetTableStatistics() const {
+  std::scoped_lock lock(statistics_mutex_);
+  return table_statistics_;
+}
+
+const LatencyHistogram &Disk::GetReadLatency() const { return read_latency_; }
+
+const LatencyHistogram &Disk::GetWriteLatency() const { return write_latency_; }
+
+const LatencyHistogram &Disk::GetLogWriteLatency() const { return log_write_latency_; }
+
+void Disk::Preallocate(int fd, oid_t db_oid, oid_t table_oid, pageid_t page_id) {
+  std::scoped_lock lock(extents_mutex_);
+  auto &allocated = allocated_pages_[GetFileKey(db_oid, table_oid)];
+  if (page_id < allocated) {
+    return;
   }
-  if (offset + count > log_segments * LOG_SEGMENT_SIZE) {
-    log_segments++;
-    std::filesystem::resize_file(LOG_NAME, log_segments * LOG_SEGMENT_SIZE);
+  // 区间的边界只取决于区间大小的规则，与页面写入的顺序无关
+  size_t target = allocated;
+  while (target <= page_id) {
+    target += std::clamp(target, FILE_EXTENT_PAGES, MAX_FILE_EXTENT_PAGES);
+  }
+  // 预分配失败时同样推进区间边界，不对同一区间反复尝试
+  if (fallocate_supported_) {
+    if (fallocate(fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(allocated * page_size_),
+                  static_cast<off_t>((target - allocated) * page_size_)) == 0) {
+      extend_count_++;
+    } else if (errno == EOPNOTSUPP || errno == ENOSYS) {
+      fallocate_supported_ = false;
+    }
   }
-  log_fs_.seekp(offset);
-  log_fs_.write(data, count);
-  log_fs_.flush();
+  allocated = target;
 }
 
-uint32_t Disk::GetAccessCount() const { return access_count_; }
+void Disk::RecordPageIO(oid_t db_oid, oid_t table_oid, IOOpcode opcode, std::chrono::steady_clock::time_point start) {
+  auto latency = std::chrono::steady_clock::now() - start;
+  std::scoped_lock lock(statistics_mutex_);
+  auto &statistics = table_statistics_[table_oid];
+  statistics.db_oid_ = db_oid;
+  if (opcode == IOOpcode::READ) {
+    statistics.read_bytes_ += page_size_;
+    read_latency_.Record(latency);
+  } else {
+    statistics.write_bytes_ += page_size_;
+    write_latency_.Record(latency);
+  }
+}
 
 std::string Disk::GetFilePath(oid_t db_oid, oid_t table_oid) {
+  if ((table_oid & OVERFLOW_OID_FLAG) != 0) {
+    return std::to_string(db_oid) + "/" + std::to_string(table_oid & ~OVERFLOW_OID_FLAG) + OVERFLOW_SUFFIX;
+  }
   return std::to_string(db_oid) + "/" + std::to_string(table_oid);
 }
 
-std::pair<oid_t, oid_t> Disk::GetOid(const std::string &path) {
-  auto oids = StringUtil::Split(path, '/');
-  return {std::stoi(oids[0]), std::stoi(oids[1])};
+uint64_t Disk::GetFileKey(oid_t db_oid, oid_t table_oid) { return uint64_t{db_oid} << 32 | table_oid; }
+
+int Disk::GetFd(std::shared_lock<std::shared_mutex> &lock, oid_t db_oid, oid_t table_oid) const {
+  auto key = GetFileKey(db_oid, table_oid);
+  while (true) {
+    auto entry = fds_.find(key);
+    if (entry != fds_.end()) {
+      return entry->second;
+    }
+    // 打开文件需修改 fds_，释放共享锁后获取独占锁
+    lock.unlock();
+    bool exists = true;
+    {
+      std::unique_lock file_lock(files_latch_);
+      if (fds_.count(key) == 0) {
+        int fd = open(GetFilePath(db_oid, table_oid).c_str(), O_RDWR | (direct_io_ ? O_DIRECT : 0));
+        if (fd >= 0) {
+          fds_[key] = fd;
+        } else if (errno == ENOENT) {
+          exists = false;
+        } else {
+          throw DbException("open file " + GetFilePath(db_oid, table_oid) + " failed: " + strerror(errno));
+        }
+      }
+    }
+    lock.lock();
+    if (!exists) {
+      return -1;
+    }
+  }
+}
+
+void Disk::ExtendLog(size_t end) {
+  std::scoped_lock lock(log_mutex_);
+  if (end > log_segments * LOG_SEGMENT_SIZE) {
+    log_segments = (end + LOG_SEGMENT_SIZE - 1) / LOG_SEGMENT_SIZE;
+    std::filesystem::resize_file(LOG_NAME, log_segments * LOG_SEGMENT_SIZE);
+  }
 }
 
 }  // namespace huadb
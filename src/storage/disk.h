@@ -1,17 +1,41 @@
 #pragma once
 
-#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
-#include <utility>
+#include <vector>
 
+#include "common/constants.h"
 #include "common/types.h"
+#include "storage/io_engine.h"
+#include "storage/io_statistics.h"
 
 namespace huadb {
 
+// 批量页面读写请求
+struct PageIO {
+  oid_t db_oid_;
+  oid_t table_oid_;
+  pageid_t page_id_;
+  char *data_;
+};
+
+// 批量日志写入请求
+struct LogIO {
+  uint32_t offset_;
+  uint32_t count_;
+  const char *data_;
+};
+
 class Disk {
  public:
-  Disk();
+  // direct_io 为 true 时以 O_DIRECT 方式读写表文件，绕过操作系统页缓存，页面大小需为 DIRECT_IO_ALIGNMENT 的整数倍
+  // 页面大小初始为 DEFAULT_PAGE_SIZE，可在读写表文件前通过 SetPageSize 修改
+  explicit Disk(IOEngineType io_engine_type = IOEngineType::SYNC, bool direct_io = false);
   ~Disk();
   static bool DirectoryExists(const std::string &path);
   static void ChangeDirectory(const std::string &path);
@@ -24,26 +48,91 @@ class Disk {
   static void CreateFile(const std::string &path);
   static void RemoveFile(const std::string &path);
 
-  void OpenFile(const std::string &path);
-  void CloseFile(const std::string &path);
+  // 设置表文件的页面大小，页面大小不合法时抛出异常，需在读写表文件前调用
+  void SetPageSize(size_t page_size);
+  size_t GetPageSize() const;
+  // 表文件中的页面数目，文件不存在时返回 0；通过缓存的文件描述符获取文件长度，文件未打开时先打开文件
+  size_t GetPageCount(oid_t db_oid, oid_t table_oid) const;
+  // 将表文件截断为 page_count 个页面，文件中的页面不多于 page_count 时不做修改
+  // 截断同时释放文件末尾预分配的空间
+  void TruncateFile(oid_t db_oid, oid_t table_oid, size_t page_count);
 
-  void ReadPage(const std::string &path, pageid_t page_id, char *data);
-  void WritePage(const std::string &path, pageid_t page_id, const char *data);
+  // 关闭表文件，删除表文件前调用，避免之后的读写仍使用已删除文件的描述符
+  void CloseFile(oid_t db_oid, oid_t table_oid);
+  // 关闭数据库中的所有表文件，删除数据库目录前调用
+  void CloseDatabaseFiles(oid_t db_oid);
+
+  // 单个页面的同步读写直接使用 pread/pwrite
+  // 写入已分配区间之外的页面前先按区间预分配文件空间，见 Preallocate
+  void ReadPage(oid_t db_oid, oid_t table_oid, pageid_t page_id, char *data);
+  void WritePage(oid_t db_oid, oid_t table_oid, pageid_t page_id, const char *data);
+  // 通过 I/O 引擎批量读写页面，每个页面读写完成时调用 callback，全部完成后返回
+  // 写入已删除的文件的页面被忽略，视为写入成功；同一文件中连续的页面合并为一次向量化写入
+  void ReadPages(const std::vector<PageIO> &pages, const IOCallback &callback);
+  void WritePages(const std::vector<PageIO> &pages, const IOCallback &callback);
 
   void ReadLog(uint32_t offset, uint32_t count, char *data);
   void WriteLog(uint32_t offset, uint32_t count, const char *data);
+  // 通过 I/O 引擎批量写入日志，任一日志写入失败时抛出异常
+  void WriteLogs(const std::vector<LogIO> &logs);
+
+  // 实际使用的 I/O 引擎类型，io_uring 不可用时为 SYNC
+  IOEngineType GetIOEngineType() const;
+  // 是否以 O_DIRECT 方式读写表文件，页面大小不满足对齐要求时为 false
+  bool IsDirectIO() const;
 
-  uint32_t GetAccessCount() const;
+  uint64_t GetAccessCount() const;
+  // 为表文件成功预分配区间的次数，文件系统不支持 fallocate 或预分配失败时不计入
+  uint64_t GetExtendCount() const;
+  // 各表的读写字节数，以表 oid 为键，只有 db_oid_、read_bytes_ 和 write_bytes_ 有效
+  std::unordered_map<oid_t, TableStatistics> GetTableStatistics() const;
+  // 表文件页面读写和日志写入的延迟分布，批量读写的延迟为从提交批次到该页面完成的时间
+  const LatencyHistogram &GetReadLatency() const;
+  const LatencyHistogram &GetWriteLatency() const;
+  const LatencyHistogram &GetLogWriteLatency() const;
 
+  // 表文件的路径，table_oid 带有 OVERFLOW_OID_FLAG 时为表的溢出文件
   static std::string GetFilePath(oid_t db_oid, oid_t table_oid);
 
  private:
-  static std::pair<oid_t, oid_t> GetOid(const std::string &path);
-  std::unordered_map<std::string, std::fstream> hashmap_;  // 文件路径到 fstream 的映射表
-  std::fstream log_fs_;
+  // 文件描述符表的键，由数据库 oid 和表 oid 组成
+  static uint64_t GetFileKey(oid_t db_oid, oid_t table_oid);
+  // 获取表文件的描述符，文件未打开时打开文件，文件不存在时返回 -1
+  // 调用时需持有 files_latch_ 的共享锁，打开文件时会暂时释放共享锁
+  int GetFd(std::shared_lock<std::shared_mutex> &lock, oid_t db_oid, oid_t table_oid) const;
+  // 记录一次成功的表文件页面读写
+  void RecordPageIO(oid_t db_oid, oid_t table_oid, IOOpcode opcode, std::chrono::steady_clock::time_point start);
+  // 写入页面 page_id 前调用，页面超出文件已分配的区间时按区间预分配文件空间
+  // 预分配使用 fallocate 的 FALLOC_FL_KEEP_SIZE 模式，只分配磁盘块而不改变文件长度，文件长度仍为已写入的页面数目
+  // 文件连续增长时，磁盘块按区间连续分配，减少碎片和每次扩展文件时分配磁盘块的元数据更新
+  // 预分配只是优化，文件系统不支持或空间不足时忽略，之后的写入照常扩展文件
+  void Preallocate(int fd, oid_t db_oid, oid_t table_oid, pageid_t page_id);
+  // 日志文件长度不足 end 时按段扩展日志文件
+  void ExtendLog(size_t end);
+  // 表文件到文件描述符的映射表，是已打开文件的缓存，只读的操作（如 GetPageCount）也可以打开文件
+  mutable std::unordered_map<uint64_t, int> fds_;
+  mutable std::shared_mutex files_latch_;  // 保护 fds_，读写文件期间持有共享锁，关闭文件时持有独占锁
+  size_t page_size_ = DEFAULT_PAGE_SIZE;
+  bool request_direct_io_;  // 是否请求以 O_DIRECT 方式读写，页面大小满足对齐要求时才启用
+  bool direct_io_;
+  int log_fd_ = -1;
+  std::mutex log_mutex_;  // 保护 log_segments
+
+  std::unique_ptr<IOEngine> io_engine_;
+  std::atomic<uint64_t> access_count_ = 0;  // 磁盘访问次数
+  std::mutex extents_mutex_;                // 保护 allocated_pages_
+  // 表文件已预分配的页面数目，文件关闭或截断后移除，重新打开的文件从 0 开始重新计算区间，
+  // 对已分配的范围再次调用 fallocate 不会分配新的磁盘块
+  std::unordered_map<uint64_t, size_t> allocated_pages_;
+  std::atomic<bool> fallocate_supported_ = true;  // 文件系统不支持 fallocate 时不再尝试预分配
+  std::atomic<uint64_t> extend_count_ = 0;
+  uint32_t log_segments = 0;                // 日志段数
 
-  uint32_t access_count_ = 0;  // 磁盘访问次数
-  uint32_t log_segments = 0;   // 日志段数
+  mutable std::mutex statistics_mutex_;                          // 保护 table_statistics_
+  std::unordered_map<oid_t, TableStatistics> table_statistics_;  // 各表的读写字节数
+  LatencyHistogram read_latency_;
+  LatencyHistogram write_latency_;
+  LatencyHistogram log_write_latency_;
 };
 
 }  // namespace huadb
@@ -0,0 +1,274 @@
+#include "storage/io_engine.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "common/constants.h"
+#include "common/exceptions.h"
+
+namespace huadb {
+
+std::unique_ptr<IOEngine> IOEngine::Create(IOEngineType type) {
+  if (type == IOEngineType::IO_URING) {
+    try {
+      return std::make_unique<IOUringEngine>(IO_QUEUE_DEPTH);
+    } catch (DbException &) {
+      // 内核不支持或禁用了 io_uring（如部分容器环境），使用同步 I/O
+    }
+  }
+  return std::make_unique<SyncIOEngine>();
+}
+
+std::vector<iovec> IOEngine::RemainingIovecs(const std::vector<iovec> &iovecs, size_t done) {
+  std::vector<iovec> remaining;
+  for (const auto &vec : iovecs) {
+    if (done >= vec.iov_len) {
+      done -= vec.iov_len;
+      continue;
+    }
+    remaining.push_back({static_cast<char *>(vec.iov_base) + done, vec.iov_len - done});
+    done = 0;
+  }
+  return remaining;
+}
+
+IOEngineType SyncIOEngine::GetType() const { return IOEngineType::SYNC; }
+
+bool SyncIOEngine::ExecuteRequest(const IORequest &request) {
+  size_t done = 0;
+  while (done < request.size_) {
+    ssize_t result;
+    if (!request.iovecs_.empty()) {
+      auto iovecs = done == 0 ? request.iovecs_ : RemainingIovecs(request.iovecs_, done);
+      if (request.opcode_ == IOOpcode::READ) {
+        result = preadv(request.fd_, iovecs.data(), iovecs.size(), request.offset_ + done);
+      } else {
+        result = pwritev(request.fd_, iovecs.data(), iovecs.size(), request.offset_ + done);
+      }
+    } else if (request.opcode_ == IOOpcode::READ) {
+      result = pread(request.fd_, request.data_ + done, request.size_ - done, request.offset_ + done);
+    } else {
+      result = pwrite(request.fd_, request.data_ + done, request.size_ - done, request.offset_ + done);
+    }
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    // 出错或读到文件末尾
+    if (result <= 0) {
+      return false;
+    }
+    done += result;
+  }
+  return true;
+}
+
+void SyncIOEngine::Execute(const std::vector<IORequest> &requests, const IOCallback &callback) {
+  for (size_t i = 0; i < requests.size(); i++) {
+    callback(i, ExecuteRequest(requests[i]));
+  }
+}
+
+IOUringEngine::IOUringEngine(unsigned queue_depth) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = syscall(__NR_io_uring_setup, queue_depth, &params);
+  if (ring_fd_ < 0) {
+    throw DbException(std::string("io_uring_setup failed: ") + strerror(errno));
+  }
+  // IORING_OP_READ 与 IORING_OP_WRITE 和 IORING_FEAT_RW_CUR_POS 在同一内核版本（5.6）引入
+  if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+    close(ring_fd_);
+    throw DbException("io_uring does not support IORING_OP_READ and IORING_OP_WRITE");
+  }
+  entries_ = params.sq_entries;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                  IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    close(ring_fd_);
+    throw DbException("mmap io_uring submission queue failed");
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                    IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      munmap(sq_ring_, sq_ring_size_);
+      close(ring_fd_);
+      throw DbException("mmap io_uring completion queue failed");
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    if (!single_mmap) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    munmap(sq_ring_, sq_ring_size_);
+    close(ring_fd_);
+    throw DbException("mmap io_uring submission queue entries failed");
+  }
+
+  auto *sq = static_cast<char *>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+  auto *cq = static_cast<char *>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+}
+
+IOUringEngine::~IOUringEngine() {
+  munmap(sqes_, sqes_size_);
+  if (cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  munmap(sq_ring_, sq_ring_size_);
+  close(ring_fd_);
+}
+
+IOEngineType IOUringEngine::GetType() const { return IOEngineType::IO_URING; }
+
+void IOUringEngine::Execute(const std::vector<IORequest> &requests, const IOCallback &callback) {
+  std::scoped_lock lock(ring_mutex_);
+  // 每个请求已完成的字节数，短读写时提交剩余部分
+  std::vector<size_t> done(requests.size(), 0);
+  // 向量化请求短读写时剩余部分的缓冲区
+  std::vector<std::vector<iovec>> remaining(requests.size());
+  std::deque<size_t> resubmits;
+  size_t next = 0;
+  size_t inflight = 0;
+  size_t completed = 0;
+  try {
+    while (completed < requests.size()) {
+      while (inflight < entries_ && (!resubmits.empty() || next < requests.size())) {
+        size_t index;
+        if (!resubmits.empty()) {
+          index = resubmits.front();
+          resubmits.pop_front();
+        } else {
+          index = next++;
+        }
+        const auto &request = requests[index];
+        if (done[index] == 0) {
+          PrepareRequest(request, index, 0, request.iovecs_);
+        } else {
+          remaining[index] = RemainingIovecs(request.iovecs_, done[index]);
+          PrepareRequest(request, index, done[index], remaining[index]);
+        }
+        inflight++;
+      }
+      Enter(1);
+
+      unsigned head = *cq_head_;
+      unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      for (; head != tail; head++) {
+        const auto &cqe = static_cast<io_uring_cqe *>(cqes_)[head & *cq_mask_];
+        size_t index = cqe.user_data;
+        int res = cqe.res;
+        // 先消费完成事件再调用 callback，callback 抛出异常时该事件不会被 Drain 重复计入
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        inflight--;
+        if (res == -EINTR || res == -EAGAIN) {
+          resubmits.push_back(index);
+          continue;
+        }
+        // 出错或读到文件末尾
+        if (res <= 0) {
+          completed++;
+          callback(index, false);
+          continue;
+        }
+        done[index] += res;
+        if (done[index] < requests[index].size_) {
+          resubmits.push_back(index);
+        } else {
+          completed++;
+          callback(index, true);
+        }
+      }
+    }
+  } catch (...) {
+    // 在途请求仍引用调用者的页面缓冲区和 remaining 中的 iovec，需等待其完成后才能返回
+    Drain(inflight);
+    throw;
+  }
+}
+
+void IOUringEngine::PrepareRequest(const IORequest &request, size_t index, size_t done,
+                                   const std::vector<iovec> &iovecs) {
+  unsigned tail = *sq_tail_;
+  unsigned sq_index = tail & *sq_mask_;
+  auto &sqe = static_cast<io_uring_sqe *>(sqes_)[sq_index];
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.fd = request.fd_;
+  if (request.iovecs_.empty()) {
+    sqe.opcode = request.opcode_ == IOOpcode::READ ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe.addr = reinterpret_cast<uint64_t>(request.data_ + done);
+    sqe.len = request.size_ - done;
+  } else {
+    sqe.opcode = request.opcode_ == IOOpcode::READ ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe.addr = reinterpret_cast<uint64_t>(iovecs.data());
+    sqe.len = iovecs.size();
+  }
+  sqe.off = request.offset_ + done;
+  sqe.user_data = index;
+  sq_array_[sq_index] = sq_index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+}
+
+void IOUringEngine::Enter(unsigned min_complete) {
+  while (true) {
+    // 内核消费的请求数可能少于提交数，未被消费的请求留在提交队列中，下次调用时一并提交
+    unsigned to_submit = *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    int result = syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, IORING_ENTER_GETEVENTS, nullptr, 0);
+    if (result >= 0) {
+      return;
+    }
+    if (errno != EINTR) {
+      throw DbException(std::string("io_uring_enter failed: ") + strerror(errno));
+    }
+  }
+}
+
+void IOUringEngine::Drain(size_t inflight) {
+  // 不使用 SQPOLL，内核只在 io_uring_enter 中消费提交队列，持有 ring_mutex_ 时可以直接回退队尾
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  inflight -= *sq_tail_ - head;
+  __atomic_store_n(sq_tail_, head, __ATOMIC_RELEASE);
+  while (inflight > 0) {
+    unsigned cq_head = *cq_head_;
+    unsigned cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (cq_head == cq_tail) {
+      // 只等待不提交；io_uring_enter 失败时让出 CPU 后轮询完成队列，内核仍会为在途请求写入完成事件
+      if (syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0) {
+        std::this_thread::yield();
+      }
+      continue;
+    }
+    inflight -= cq_tail - cq_head;
+    __atomic_store_n(cq_head_, cq_tail, __ATOMIC_RELEASE);
+  }
+}
+
+}  // namespace huadb
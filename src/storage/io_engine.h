@@ -0,0 +1,101 @@
+#pragma once
+
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace huadb {
+
+// I/O 引擎类型
+enum class IOEngineType { SYNC, IO_URING };
+
+enum class IOOpcode { READ, WRITE };
+
+// 一次文件读写请求，读请求将数据读入 data_，写请求将 data_ 写入文件
+// iovecs_ 非空时为向量化读写，从 offset_ 开始依次读写 iovecs_ 中的各个缓冲区，此时 data_ 不使用，size_ 为缓冲区总长度
+struct IORequest {
+  IOOpcode opcode_;
+  int fd_;
+  char *data_;
+  size_t size_;
+  uint64_t offset_;
+  std::vector<iovec> iovecs_;
+};
+
+// 请求完成时的回调，参数为请求在批次中的下标，以及请求是否成功读写了全部数据
+using IOCallback = std::function<void(size_t, bool)>;
+
+// 批量执行文件读写请求的 I/O 引擎
+class IOEngine {
+ public:
+  virtual ~IOEngine() = default;
+  // 创建 I/O 引擎，io_uring 不可用时退化为同步 I/O 引擎
+  static std::unique_ptr<IOEngine> Create(IOEngineType type);
+
+  virtual IOEngineType GetType() const = 0;
+  // 执行一批请求，每个请求完成时（按完成顺序）调用 callback，全部请求完成后返回
+  // 单个请求失败不抛出异常，由 callback 的参数告知调用者
+  virtual void Execute(const std::vector<IORequest> &requests, const IOCallback &callback) = 0;
+
+ protected:
+  // 向量化请求已完成 done 字节后，剩余部分对应的缓冲区
+  static std::vector<iovec> RemainingIovecs(const std::vector<iovec> &iovecs, size_t done);
+};
+
+// 使用 pread/pwrite 逐个执行请求
+class SyncIOEngine : public IOEngine {
+ public:
+  // 同步执行单个请求，返回是否读写了全部数据
+  static bool ExecuteRequest(const IORequest &request);
+
+  IOEngineType GetType() const override;
+  void Execute(const std::vector<IORequest> &requests, const IOCallback &callback) override;
+};
+
+// 基于 Linux io_uring 的 I/O 引擎，一次系统调用提交多个请求，最多保持 queue_depth 个请求同时在途
+class IOUringEngine : public IOEngine {
+ public:
+  explicit IOUringEngine(unsigned queue_depth);
+  ~IOUringEngine() override;
+
+  IOEngineType GetType() const override;
+  void Execute(const std::vector<IORequest> &requests, const IOCallback &callback) override;
+
+ private:
+  // 将请求从 done 字节处开始的剩余部分放入提交队列，user_data 为请求下标
+  // 向量化请求的剩余部分由 iovecs 给出，iovecs 需在请求完成前保持有效
+  void PrepareRequest(const IORequest &request, size_t index, size_t done, const std::vector<iovec> &iovecs);
+  // 提交队列中尚未提交的请求，并等待至少 min_complete 个请求完成
+  void Enter(unsigned min_complete);
+  // 批次出错返回前调用：撤回提交队列中尚未被内核消费的请求，等待其余 inflight 个在途请求完成并丢弃其完成事件
+  // 避免内核在请求的缓冲区释放后继续读写，以及之后的批次收到本批次的完成事件
+  void Drain(size_t inflight);
+
+  int ring_fd_ = -1;
+  unsigned entries_ = 0;
+  std::mutex ring_mutex_;  // 同一时刻只有一个批次使用提交队列和完成队列
+
+  void *sq_ring_ = nullptr;
+  void *cq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  size_t cq_ring_size_ = 0;
+  void *sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  // 提交队列与完成队列中与内核共享的字段
+  unsigned *sq_head_ = nullptr;
+  unsigned *sq_tail_ = nullptr;
+  unsigned *sq_mask_ = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned *cq_head_ = nullptr;
+  unsigned *cq_tail_ = nullptr;
+  unsigned *cq_mask_ = nullptr;
+  void *cqes_ = nullptr;
+};
+
+}  // namespace huadb
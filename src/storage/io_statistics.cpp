@@ -0,0 +1,47 @@
+#include "storage/io_statistics.h"
+
+#include <algorithm>
+
+namespace huadb {
+
+TableStatistics &TableStatistics::operator+=(const TableStatistics &other) {
+  if (db_oid_ == INVALID_OID) {
+    db_oid_ = other.db_oid_;
+  }
+  hits_ += other.hits_;
+  misses_ += other.misses_;
+  evictions_ += other.evictions_;
+  dirty_writes_ += other.dirty_writes_;
+  read_bytes_ += other.read_bytes_;
+  write_bytes_ += other.write_bytes_;
+  return *this;
+}
+
+void LatencyHistogram::Record(std::chrono::nanoseconds latency) {
+  auto micros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+  // 延迟为 [2^(i-1), 2^i) 微秒时，micros 的二进制位数为 i
+  size_t bucket = 0;
+  while (micros > 0) {
+    micros >>= 1;
+    bucket++;
+  }
+  counts_[std::min(bucket, BUCKET_COUNT - 1)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> LatencyHistogram::GetCounts() const {
+  std::vector<uint64_t> counts;
+  counts.reserve(BUCKET_COUNT);
+  for (const auto &count : counts_) {
+    counts.push_back(count.load(std::memory_order_relaxed));
+  }
+  return counts;
+}
+
+std::string LatencyHistogram::GetBucketName(size_t bucket) {
+  if (bucket == BUCKET_COUNT - 1) {
+    return ">=" + std::to_string(uint64_t{1} << (bucket - 1)) + "us";
+  }
+  return "<" + std::to_string(uint64_t{1} << bucket) + "us";
+}
+
+}  // namespace huadb
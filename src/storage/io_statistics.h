@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/constants.h"
+
+namespace huadb {
+
+// 表的缓存与磁盘读写统计，缓存相关的计数由 buffer pool 维护，读写字节数由 Disk 维护
+struct TableStatistics {
+  oid_t db_oid_ = INVALID_OID;
+  uint64_t hits_ = 0;          // 获取页面时页面已在缓存中的次数
+  uint64_t misses_ = 0;        // 获取页面时需要从磁盘读取的次数，不含预读
+  uint64_t evictions_ = 0;     // 页面被淘汰出缓存的次数
+  uint64_t dirty_writes_ = 0;  // 脏页被写回磁盘的次数
+  uint64_t read_bytes_ = 0;    // 从表文件读取的字节数
+  uint64_t write_bytes_ = 0;   // 写入表文件的字节数
+
+  TableStatistics &operator+=(const TableStatistics &other);
+};
+
+// I/O 延迟直方图，线程安全
+// 第 0 个桶统计延迟小于 1 微秒的次数，第 i 个桶统计延迟在 [2^(i-1), 2^i) 微秒内的次数，最后一个桶统计更长的延迟
+class LatencyHistogram {
+ public:
+  static constexpr size_t BUCKET_COUNT = 20;
+
+  void Record(std::chrono::nanoseconds latency);
+  // 各个桶的计数
+  std::vector<uint64_t> GetCounts() const;
+  // 桶的名称，如 "<1us"、"<2us"、">=262144us"
+  static std::string GetBucketName(size_t bucket);
+
+ private:
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts_{};
+};
+
+}  // namespace huadb
@@ -1,17 +1,38 @@
 #include "storage/lru_buffer_strategy.h"
 
+#include "common/constants.h"
+
 namespace huadb {
 
 void LRUBufferStrategy::Access(size_t frame_no) {
-  // 缓存页面访问
-  // LAB 1 BEGIN
-  return;
+  lru_.remove(frame_no);
+  lru_.push_back(frame_no);
 };
 
 size_t LRUBufferStrategy::Evict() {
-  // 缓存页面淘汰，返回淘汰的页面在 buffer pool 中的下标
-  // LAB 1 BEGIN
-  return 0;
+  for (auto it = lru_.begin(); it != lru_.end(); it++) {
+    if (IsEvictable(*it)) {
+      auto f = *it;
+      lru_.erase(it);
+      return f;
+    }
+  }
+  return INVALID_FRAME_ID;
+}
+
+void LRUBufferStrategy::Remove(size_t frame_no) { lru_.remove(frame_no); }
+
+std::vector<size_t> LRUBufferStrategy::GetEvictionCandidates(size_t count) const {
+  std::vector<size_t> candidates;
+  for (auto f : lru_) {
+    if (candidates.size() >= count) {
+      break;
+    }
+    if (IsEvictable(f)) {
+      candidates.push_back(f);
+    }
+  }
+  return candidates;
 }
 
 }  // namespace huadb
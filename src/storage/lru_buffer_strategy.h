@@ -1,5 +1,7 @@
 #pragma once
 
+#include <list>
+
 #include "storage/buffer_strategy.h"
 
 namespace huadb {
@@ -8,6 +10,11 @@ class LRUBufferStrategy : public BufferStrategy {
  public:
   void Access(size_t frame_no) override;
   size_t Evict() override;
+  void Remove(size_t frame_no) override;
+  std::vector<size_t> GetEvictionCandidates(size_t count) const override;
+
+ private:
+  std::list<size_t> lru_;
 };
 
 }  // namespace huadb
@@ -0,0 +1,89 @@
+#include "storage/lru_k_buffer_strategy.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "common/constants.h"
+#include "common/exceptions.h"
+
+namespace huadb {
+
+LRUKBufferStrategy::LRUKBufferStrategy(size_t k) : k_(k), last_frame_(INVALID_FRAME_ID) {
+  if (k_ == 0) {
+    throw DbException("K of LRU-K must be positive");
+  }
+}
+
+void LRUKBufferStrategy::Access(size_t frame_no) {
+  if (frame_no >= history_.size()) {
+    history_.resize(frame_no + 1);
+  }
+  auto &history = history_[frame_no];
+  current_timestamp_++;
+  if (frame_no == last_frame_ && !history.empty()) {
+    history.back() = current_timestamp_;
+    return;
+  }
+  last_frame_ = frame_no;
+  if (history.size() == k_) {
+    history.erase(history.begin());
+  }
+  history.push_back(current_timestamp_);
+}
+
+size_t LRUKBufferStrategy::Evict() {
+  size_t victim = INVALID_FRAME_ID;
+  bool victim_full = true;
+  size_t victim_timestamp = 0;
+  for (size_t frame_no = 0; frame_no < history_.size(); frame_no++) {
+    const auto &history = history_[frame_no];
+    if (history.empty() || !IsEvictable(frame_no)) {
+      continue;
+    }
+    // 访问次数不足 K 次时比较第一次访问时间，否则比较倒数第 K 次访问时间，二者均为 history 的首个元素
+    bool full = history.size() == k_;
+    size_t timestamp = history.front();
+    if (victim == INVALID_FRAME_ID || (!full && victim_full) || (full == victim_full && timestamp < victim_timestamp)) {
+      victim = frame_no;
+      victim_full = full;
+      victim_timestamp = timestamp;
+    }
+  }
+  if (victim != INVALID_FRAME_ID) {
+    history_[victim].clear();
+    if (last_frame_ == victim) {
+      last_frame_ = INVALID_FRAME_ID;
+    }
+  }
+  return victim;
+}
+
+void LRUKBufferStrategy::Remove(size_t frame_no) {
+  if (frame_no >= history_.size()) {
+    return;
+  }
+  history_[frame_no].clear();
+  if (last_frame_ == frame_no) {
+    last_frame_ = INVALID_FRAME_ID;
+  }
+}
+
+std::vector<size_t> LRUKBufferStrategy::GetEvictionCandidates(size_t count) const {
+  // 排序键与 Evict 相同：访问次数不足 K 次的页帧在前，再按 history 的首个元素排序
+  std::vector<std::tuple<bool, size_t, size_t>> frames;
+  for (size_t frame_no = 0; frame_no < history_.size(); frame_no++) {
+    const auto &history = history_[frame_no];
+    if (!history.empty() && IsEvictable(frame_no)) {
+      frames.emplace_back(history.size() == k_, history.front(), frame_no);
+    }
+  }
+  count = std::min(count, frames.size());
+  std::partial_sort(frames.begin(), frames.begin() + count, frames.end());
+  std::vector<size_t> candidates;
+  for (size_t i = 0; i < count; i++) {
+    candidates.push_back(std::get<2>(frames[i]));
+  }
+  return candidates;
+}
+
+}  // namespace huadb
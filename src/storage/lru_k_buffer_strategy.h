@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+#include "storage/buffer_strategy.h"
+
+namespace huadb {
+
+// LRU-K 替换策略，淘汰倒数第 K 次访问时间最早的页帧
+// 访问次数不足 K 次的页帧视为距离无穷大，优先淘汰，其中最早被访问的页帧先被淘汰
+// 对同一页帧的连续访问（如顺序扫描逐条读取页面中的记录）视为一次相关访问，只更新最近一次访问时间
+class LRUKBufferStrategy : public BufferStrategy {
+ public:
+  explicit LRUKBufferStrategy(size_t k = 2);
+
+  void Access(size_t frame_no) override;
+  size_t Evict() override;
+  void Remove(size_t frame_no) override;
+  std::vector<size_t> GetEvictionCandidates(size_t count) const override;
+
+ private:
+  size_t k_;
+  // 逻辑时钟，每次访问加一
+  size_t current_timestamp_ = 0;
+  // 上一次访问的页帧
+  size_t last_frame_;
+  // 每个页帧最近 K 次访问的时间，按时间从早到晚排列，为空表示页帧不在缓存中
+  std::vector<std::vector<size_t>> history_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,62 @@
+#include "storage/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "common/constants.h"
+#include "common/exceptions.h"
+#include "storage/disk.h"
+
+namespace huadb {
+
+MappedFile::MappedFile(oid_t db_oid, oid_t table_oid, size_t page_size) : page_size_(page_size) {
+  auto path = Disk::GetFilePath(db_oid, table_oid);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw DbException("open " + path + " failed in MappedFile::MappedFile: " + strerror(errno));
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0) {
+    close(fd);
+    throw DbException("fstat " + path + " failed: " + strerror(errno));
+  }
+  page_count_ = file_stat.st_size / page_size_;
+  if (page_count_ == 0) {
+    close(fd);
+    throw DbException("Cannot map empty file " + path);
+  }
+  void *data = mmap(nullptr, page_count_ * page_size_, PROT_READ, MAP_SHARED, fd, 0);
+  // 映射建立后即可关闭文件描述符，映射仍然有效
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw DbException("mmap " + path + " failed: " + strerror(errno));
+  }
+  data_ = static_cast<char *>(data);
+  // 顺序访问提示只影响内核预读，失败时不影响正确性
+  madvise(data_, page_count_ * page_size_, MADV_SEQUENTIAL);
+  pages_.resize(page_count_);
+}
+
+MappedFile::~MappedFile() { munmap(data_, page_count_ * page_size_); }
+
+size_t MappedFile::GetPageCount() const { return page_count_; }
+
+ReadPageGuard MappedFile::FetchPage(pageid_t page_id) {
+  if (page_id >= page_count_) {
+    throw DbException("Page " + std::to_string(page_id) + " is out of the mapped range");
+  }
+  auto &page = pages_[page_id];
+  if (page == nullptr) {
+    // 映射为只读，通过只读页面守卫访问的页面不会被修改
+    page = std::make_unique<Page>(data_ + size_t{page_id} * page_size_, page_size_);
+  }
+  return ReadPageGuard(nullptr, PageGuard::NO_FRAME, page.get());
+}
+
+}  // namespace huadb
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/types.h"
+#include "storage/page.h"
+#include "storage/page_guard.h"
+
+namespace huadb {
+
+// 以只读方式映射到内存的表文件
+// 只读会话扫描没有脏页的表时，直接从映射内存读取页面，省去将页面读入 buffer pool 的系统调用和拷贝
+// 映射建立后追加到文件的页面不在映射范围内；扫描期间其他会话写回的页面可能被读到部分修改的内容，
+// 因此只用于不被并发修改的表（如报表查询的历史数据）
+class MappedFile {
+ public:
+  // 以 page_size 为页面大小映射表文件中的全部页面，并通过 madvise(MADV_SEQUENTIAL) 提示内核按顺序预读
+  // 文件不存在、为空或映射失败时抛出异常
+  MappedFile(oid_t db_oid, oid_t table_oid, size_t page_size);
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // 映射范围内的页面数目
+  size_t GetPageCount() const;
+  // 获取映射中的页面用于读取，页面无需 pin，页面号超出映射范围时抛出异常
+  ReadPageGuard FetchPage(pageid_t page_id);
+
+ private:
+  char *data_ = nullptr;
+  size_t page_size_;
+  size_t page_count_ = 0;
+  // 映射中各页面的 Page 对象，首次访问时创建
+  std::vector<std::unique_ptr<Page>> pages_;
+};
+
+}  // namespace huadb
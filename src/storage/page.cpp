@@ -1,12 +1,28 @@
 #include "storage/page.h"
 
+#include <cstdlib>
+
 #include "common/constants.h"
+#include "common/exceptions.h"
 
 namespace huadb {
 
-Page::Page() { data_ = new char[DB_PAGE_SIZE]; }
+Page::Page(size_t size) : size_(size), owns_data_(true) {
+  // 按直接 I/O 的要求对齐，aligned_alloc 要求分配大小为对齐大小的整数倍
+  size_t alloc_size = (size + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+  data_ = static_cast<char *>(std::aligned_alloc(DIRECT_IO_ALIGNMENT, alloc_size));
+  if (data_ == nullptr) {
+    throw DbException("Failed to allocate page");
+  }
+}
+
+Page::Page(char *data, size_t size) : data_(data), size_(size), owns_data_(false) {}
 
-Page::~Page() { delete[] data_; }
+Page::~Page() {
+  if (owns_data_) {
+    std::free(data_);
+  }
+}
 
 void Page::SetDirty() { is_dirty_ = true; }
 
@@ -14,4 +30,8 @@ bool Page::IsDirty() const { return is_dirty_; }
 
 char *Page::GetData() const { return data_; }
 
+size_t Page::GetSize() const { return size_; }
+
+void Page::Reset() { is_dirty_ = false; }
+
 }  // namespace huadb
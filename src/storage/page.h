@@ -1,18 +1,31 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+
 namespace huadb {
 
 class Page {
  public:
-  Page();
+  // 自行分配 size 字节的页面数据
+  explicit Page(size_t size);
+  // 使用外部内存（如 buffer pool 的页帧）作为页面数据，不负责释放
+  Page(char *data, size_t size);
   ~Page();
   void SetDirty();
   bool IsDirty() const;
   char *GetData() const;
+  // 页面大小，即数据目录的页面大小
+  size_t GetSize() const;
+  // 页帧复用时重置页面状态
+  void Reset();
 
  private:
   char *data_;
-  bool is_dirty_ = false;
+  size_t size_;
+  bool owns_data_;
+  // 多个线程可能同时修改和检查脏页标记
+  std::atomic<bool> is_dirty_ = false;
 };
 
 }  // namespace huadb
@@ -0,0 +1,56 @@
+#include "storage/page_guard.h"
+
+#include <utility>
+
+#include "storage/buffer_pool.h"
+
+namespace huadb {
+
+PageGuard::PageGuard(BufferPool *buffer_pool, size_t frame_id, Page *page, bool exclusive)
+    : buffer_pool_(buffer_pool), frame_id_(frame_id), page_(page), exclusive_(exclusive) {}
+
+PageGuard::PageGuard(PageGuard &&other) noexcept
+    : buffer_pool_(std::exchange(other.buffer_pool_, nullptr)),
+      frame_id_(std::exchange(other.frame_id_, NO_FRAME)),
+      page_(std::exchange(other.page_, nullptr)),
+      exclusive_(other.exclusive_) {}
+
+PageGuard &PageGuard::operator=(PageGuard &&other) noexcept {
+  if (this != &other) {
+    Release();
+    buffer_pool_ = std::exchange(other.buffer_pool_, nullptr);
+    frame_id_ = std::exchange(other.frame_id_, NO_FRAME);
+    page_ = std::exchange(other.page_, nullptr);
+    exclusive_ = other.exclusive_;
+  }
+  return *this;
+}
+
+PageGuard::~PageGuard() { Release(); }
+
+bool PageGuard::IsValid() const { return page_ != nullptr; }
+
+Page *PageGuard::GetPage() const { return page_; }
+
+void PageGuard::Release() {
+  if (buffer_pool_ != nullptr && frame_id_ != NO_FRAME) {
+    buffer_pool_->UnpinFrame(frame_id_, exclusive_);
+  }
+  buffer_pool_ = nullptr;
+  frame_id_ = NO_FRAME;
+  page_ = nullptr;
+}
+
+ReadPageGuard::ReadPageGuard(BufferPool *buffer_pool, size_t frame_id, Page *page)
+    : PageGuard(buffer_pool, frame_id, page, false) {}
+
+const char *ReadPageGuard::GetData() const { return page_->GetData(); }
+
+WritePageGuard::WritePageGuard(BufferPool *buffer_pool, size_t frame_id, Page *page)
+    : PageGuard(buffer_pool, frame_id, page, true) {}
+
+char *WritePageGuard::GetData() const { return page_->GetData(); }
+
+void WritePageGuard::SetDirty() { page_->SetDirty(); }
+
+}  // namespace huadb
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+
+#include "storage/page.h"
+
+namespace huadb {
+
+class BufferPool;
+
+// 页面守卫，持有期间页面被 pin 在 buffer pool 中，不会被淘汰，并持有页帧的页面锁；析构时自动释放页面锁并 unpin
+// 只读守卫共享持有页面锁，读写守卫独占持有，同一线程不应在持有页面的守卫时再次获取该页面的读写守卫
+// 页面守卫只能移动，不能复制
+class PageGuard {
+ public:
+  PageGuard() = default;
+  PageGuard(const PageGuard &) = delete;
+  PageGuard &operator=(const PageGuard &) = delete;
+  PageGuard(PageGuard &&other) noexcept;
+  PageGuard &operator=(PageGuard &&other) noexcept;
+  ~PageGuard();
+
+  // 是否持有页面
+  bool IsValid() const;
+  // 获取页面
+  Page *GetPage() const;
+  // 提前释放页面，之后守卫不再持有页面
+  void Release();
+
+ protected:
+  friend class BufferPool;
+  friend class MappedFile;
+  // frame_id 为 NO_FRAME 时表示页面不在 buffer pool 中（如映射文件中的页面），无需 unpin
+  static constexpr size_t NO_FRAME = -1;
+
+  PageGuard(BufferPool *buffer_pool, size_t frame_id, Page *page, bool exclusive);
+
+  BufferPool *buffer_pool_ = nullptr;
+  size_t frame_id_ = NO_FRAME;
+  Page *page_ = nullptr;
+  bool exclusive_ = false;  // 是否独占持有页面锁
+};
+
+// 只读页面守卫，用于读取页面内容
+class ReadPageGuard : public PageGuard {
+ public:
+  ReadPageGuard() = default;
+
+  const char *GetData() const;
+
+ private:
+  friend class BufferPool;
+  friend class MappedFile;
+  ReadPageGuard(BufferPool *buffer_pool, size_t frame_id, Page *page);
+};
+
+// 读写页面守卫，用于修改页面内容
+class WritePageGuard : public PageGuard {
+ public:
+  WritePageGuard() = default;
+
+  char *GetData() const;
+  // 将页面标记为脏页
+  void SetDirty();
+
+ private:
+  friend class BufferPool;
+  WritePageGuard(BufferPool *buffer_pool, size_t frame_id, Page *page);
+};
+
+}  // namespace huadb
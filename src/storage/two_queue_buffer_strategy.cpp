@@ -0,0 +1,104 @@
+#include "storage/two_queue_buffer_strategy.h"
+
+#include <algorithm>
+
+#include "common/constants.h"
+
+namespace huadb {
+
+TwoQueueBufferStrategy::TwoQueueBufferStrategy(size_t buffer_size)
+    : a1_size_(std::max<size_t>(1, buffer_size / 4)), last_frame_(INVALID_FRAME_ID) {}
+
+void TwoQueueBufferStrategy::Access(size_t frame_no) {
+  if (frame_no >= queue_types_.size()) {
+    queue_types_.resize(frame_no + 1, QueueType::NONE);
+    positions_.resize(frame_no + 1);
+  }
+  bool correlated = frame_no == last_frame_;
+  last_frame_ = frame_no;
+  switch (queue_types_[frame_no]) {
+    case QueueType::NONE:
+      queue_types_[frame_no] = QueueType::A1;
+      positions_[frame_no] = a1_.insert(a1_.end(), frame_no);
+      break;
+    case QueueType::A1:
+      if (!correlated) {
+        am_.splice(am_.end(), a1_, positions_[frame_no]);
+        queue_types_[frame_no] = QueueType::AM;
+      }
+      break;
+    case QueueType::AM:
+      am_.splice(am_.end(), am_, positions_[frame_no]);
+      break;
+  }
+}
+
+size_t TwoQueueBufferStrategy::Evict() {
+  size_t frame_no;
+  if (a1_.size() >= a1_size_ || am_.empty()) {
+    frame_no = EvictFrom(a1_);
+    if (frame_no == INVALID_FRAME_ID) {
+      frame_no = EvictFrom(am_);
+    }
+  } else {
+    frame_no = EvictFrom(am_);
+    if (frame_no == INVALID_FRAME_ID) {
+      frame_no = EvictFrom(a1_);
+    }
+  }
+  if (frame_no != INVALID_FRAME_ID && last_frame_ == frame_no) {
+    last_frame_ = INVALID_FRAME_ID;
+  }
+  return frame_no;
+}
+
+void TwoQueueBufferStrategy::Remove(size_t frame_no) {
+  if (frame_no >= queue_types_.size()) {
+    return;
+  }
+  switch (queue_types_[frame_no]) {
+    case QueueType::NONE:
+      return;
+    case QueueType::A1:
+      a1_.erase(positions_[frame_no]);
+      break;
+    case QueueType::AM:
+      am_.erase(positions_[frame_no]);
+      break;
+  }
+  queue_types_[frame_no] = QueueType::NONE;
+  if (last_frame_ == frame_no) {
+    last_frame_ = INVALID_FRAME_ID;
+  }
+}
+
+std::vector<size_t> TwoQueueBufferStrategy::GetEvictionCandidates(size_t count) const {
+  // 模拟连续淘汰的过程，期间不考虑新加入的页帧
+  std::vector<size_t> candidates;
+  auto a1_it = a1_.begin();
+  auto am_it = am_.begin();
+  size_t a1_remaining = a1_.size();
+  while (candidates.size() < count && (a1_it != a1_.end() || am_it != am_.end())) {
+    bool from_a1 = a1_it != a1_.end() && (a1_remaining >= a1_size_ || am_it == am_.end());
+    size_t frame_no = from_a1 ? *a1_it++ : *am_it++;
+    if (IsEvictable(frame_no)) {
+      candidates.push_back(frame_no);
+      a1_remaining -= from_a1;
+    }
+  }
+  return candidates;
+}
+
+size_t TwoQueueBufferStrategy::EvictFrom(std::list<size_t> &queue) {
+  for (auto it = queue.begin(); it != queue.end(); ++it) {
+    size_t frame_no = *it;
+    if (IsEvictable(frame_no)) {
+      queue.erase(it);
+      queue_types_[frame_no] = QueueType::NONE;
+      return frame_no;
+    }
+  }
+  return INVALID_FRAME_ID;
+}
+
+}  // namespace huadb
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <list>
+#include <vector>
+
+#include "storage/buffer_strategy.h"
+
+namespace huadb {
+
+// 2Q 替换策略（简化版），首次访问的页帧进入 FIFO 队列 A1，再次访问时移入 LRU 队列 Am
+// A1 中的页帧数目达到 buffer_size / 4 时优先淘汰 A1 中的页帧，使仅被扫描一次的页面不会挤出热点页面
+// 对同一页帧的连续访问视为一次相关访问，不会将页帧移入 Am
+// 由于替换策略只能看到页帧号，无法记录已淘汰页面的历史，因此不维护 A1out 队列
+class TwoQueueBufferStrategy : public BufferStrategy {
+ public:
+  explicit TwoQueueBufferStrategy(size_t buffer_size);
+
+  void Access(size_t frame_no) override;
+  size_t Evict() override;
+  void Remove(size_t frame_no) override;
+  std::vector<size_t> GetEvictionCandidates(size_t count) const override;
+
+ private:
+  enum class QueueType { NONE, A1, AM };
+
+  // 从队列头部开始查找第一个可淘汰的页帧，找不到时返回 INVALID_FRAME_ID
+  size_t EvictFrom(std::list<size_t> &queue);
+
+  // A1 队列的目标长度
+  size_t a1_size_;
+  // 上一次访问的页帧
+  size_t last_frame_;
+  // 首次访问的页帧，按进入时间排列
+  std::list<size_t> a1_;
+  // 多次访问的页帧，按最近访问时间排列
+  std::list<size_t> am_;
+  // 页帧所在的队列
+  std::vector<QueueType> queue_types_;
+  // 页帧在队列中的位置
+  std::vector<std::list<size_t>::iterator> positions_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,125 @@
+#include "table/free_space_map.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "common/constants.h"
+#include "storage/disk.h"
+
+namespace huadb {
+
+FreeSpaceMap::FreeSpaceMap(oid_t db_oid, oid_t table_oid, size_t page_size)
+    : db_oid_(db_oid),
+      table_oid_(table_oid),
+      category_size_(std::max<size_t>(1, page_size / FSM_CATEGORIES)),
+      tree_(2 * capacity_, 0) {}
+
+pageid_t FreeSpaceMap::FindPage(db_size_t size) const {
+  auto category = ToRequiredCategory(size);
+  std::scoped_lock lock(mutex_);
+  if (page_count_ == 0 || category >= FSM_CATEGORIES || tree_[1] < category) {
+    return NULL_PAGE_ID;
+  }
+  // 从根结点向下，优先进入满足条件的左子树
+  size_t node = 1;
+  while (node < capacity_) {
+    node = tree_[2 * node] >= category ? 2 * node : 2 * node + 1;
+  }
+  return node - capacity_;
+}
+
+void FreeSpaceMap::Update(pageid_t page_id, db_size_t free_space) {
+  std::scoped_lock lock(mutex_);
+  Grow(size_t{page_id} + 1);
+  SetCategory(page_id, ToCategory(free_space));
+}
+
+pageid_t FreeSpaceMap::AddPage() {
+  std::scoped_lock lock(mutex_);
+  pageid_t page_id = page_count_;
+  Grow(page_count_ + 1);
+  return page_id;
+}
+
+size_t FreeSpaceMap::GetPageCount() const {
+  std::scoped_lock lock(mutex_);
+  return page_count_;
+}
+
+void FreeSpaceMap::Truncate(size_t page_count) {
+  std::scoped_lock lock(mutex_);
+  for (size_t page_id = page_count; page_id < page_count_; page_id++) {
+    SetCategory(page_id, 0);
+  }
+  page_count_ = std::min(page_count_, page_count);
+}
+
+bool FreeSpaceMap::Load() {
+  auto path = GetPath();
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::vector<char> categories{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  in.close();
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+
+  std::scoped_lock lock(mutex_);
+  Grow(categories.size());
+  for (size_t page_id = 0; page_id < categories.size(); page_id++) {
+    SetCategory(page_id, static_cast<uint8_t>(categories[page_id]));
+  }
+  return true;
+}
+
+void FreeSpaceMap::Save() const {
+  if (!Disk::FileExists(Disk::GetFilePath(db_oid_, table_oid_))) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  std::ofstream out(GetPath(), std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(tree_.data() + capacity_), page_count_);
+}
+
+uint8_t FreeSpaceMap::ToCategory(size_t free_space) const {
+  return std::min(free_space / category_size_, FSM_CATEGORIES - 1);
+}
+
+size_t FreeSpaceMap::ToRequiredCategory(size_t size) const { return (size + category_size_ - 1) / category_size_; }
+
+void FreeSpaceMap::Grow(size_t page_count) {
+  if (page_count <= page_count_) {
+    return;
+  }
+  page_count_ = page_count;
+  if (page_count <= capacity_) {
+    return;
+  }
+  size_t capacity = capacity_;
+  while (capacity < page_count) {
+    capacity *= 2;
+  }
+  // 容量翻倍后重建线段树，均摊时间复杂度为 O(1)
+  std::vector<uint8_t> tree(2 * capacity, 0);
+  std::copy(tree_.begin() + capacity_, tree_.end(), tree.begin() + capacity);
+  for (size_t node = capacity - 1; node > 0; node--) {
+    tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+  }
+  capacity_ = capacity;
+  tree_ = std::move(tree);
+}
+
+void FreeSpaceMap::SetCategory(size_t page_id, uint8_t category) {
+  size_t node = capacity_ + page_id;
+  tree_[node] = category;
+  for (node /= 2; node > 0; node /= 2) {
+    tree_[node] = std::max(tree_[2 * node], tree_[2 * node + 1]);
+  }
+}
+
+std::string FreeSpaceMap::GetPath() const { return Disk::GetFilePath(db_oid_, table_oid_) + FSM_SUFFIX; }
+
+}  // namespace huadb
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+
+namespace huadb {
+
+// 空闲空间映射，记录表中每个页面的剩余空间，插入记录时据此直接找到剩余空间足够的页面，无需遍历表的页面
+// 页面的剩余空间以 1 字节的等级表示，等级 c 表示剩余空间至少为 c * page_size / FSM_CATEGORIES 字节
+// 内存中以最大值线段树组织，查找和更新的时间复杂度均为 O(log n)；磁盘上按页面号顺序存放各页面的等级
+// 空闲空间映射不写日志，只作为提示，可能与页面的实际剩余空间不一致，使用者需检查页面的实际剩余空间
+// 线程安全
+class FreeSpaceMap {
+ public:
+  FreeSpaceMap(oid_t db_oid, oid_t table_oid, size_t page_size);
+
+  // 查找剩余空间不小于 size 的页面，有多个时返回页面号最小的页面，没有时返回 NULL_PAGE_ID
+  pageid_t FindPage(db_size_t size) const;
+  // 更新页面的剩余空间，页面号不小于页面数目时扩展映射，中间的页面剩余空间记为 0
+  void Update(pageid_t page_id, db_size_t free_space);
+  // 为新页面分配页面号，即当前的页面数目，新页面的剩余空间记为 0
+  pageid_t AddPage();
+  // 映射中记录的页面数目
+  size_t GetPageCount() const;
+  // 表被截断为 page_count 个页面后，移除之后的页面
+  void Truncate(size_t page_count);
+
+  // 读取磁盘上的映射文件，读取后删除该文件，文件不存在时返回 false
+  // 读取后删除保证文件只在映射的使用者正常析构后存在，异常退出时文件不存在，由使用者重建映射
+  bool Load();
+  // 将映射写入磁盘，表文件已不存在（表已被删除）时不写入
+  void Save() const;
+
+ private:
+  // 剩余空间 free_space 对应的等级，向下取整
+  uint8_t ToCategory(size_t free_space) const;
+  // 容纳 size 字节所需的最低等级，向上取整
+  size_t ToRequiredCategory(size_t size) const;
+  // 扩展映射使其至少包含 page_count 个页面，调用时需持有 mutex_
+  void Grow(size_t page_count);
+  // 设置页面的等级并更新其祖先结点，调用时需持有 mutex_
+  void SetCategory(size_t page_id, uint8_t category);
+  std::string GetPath() const;
+
+  oid_t db_oid_;
+  oid_t table_oid_;
+  size_t category_size_;  // 每个等级对应的字节数
+  mutable std::mutex mutex_;
+  size_t page_count_ = 0;
+  // 线段树叶结点数目，为 2 的幂
+  size_t capacity_ = 1;
+  // 线段树，tree_[1] 为根结点，结点 i 的子结点为 2i 和 2i+1，叶结点 capacity_ + page_id 为页面的等级
+  // 内部结点为子树中的最高等级
+  std::vector<uint8_t> tree_;
+};
+
+}  // namespace huadb
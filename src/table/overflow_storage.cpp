@@ -0,0 +1,107 @@
+#include "table/overflow_storage.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "common/compression.h"
+#include "common/constants.h"
+#include "common/exceptions.h"
+#include "storage/disk.h"
+
+namespace huadb {
+
+OverflowStorage::OverflowStorage(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid)
+    : buffer_pool_(buffer_pool),
+      log_manager_(log_manager),
+      oid_(oid | OVERFLOW_OID_FLAG),
+      db_oid_(db_oid),
+      payload_size_(buffer_pool.GetPageSize() - OVERFLOW_PAGE_HEADER_SIZE) {}
+
+std::string OverflowStorage::Write(const std::string &value, bool write_log) {
+  auto compressed = Compression::LzCompress(value);
+  bool use_compressed = compressed.size() * 100 <= value.size() * (100 - OVERFLOW_MIN_COMPRESSION_SAVING);
+  const auto &data = use_compressed ? compressed : value;
+
+  std::scoped_lock lock(mutex_);
+  if (!end_loaded_) {
+    auto path = Disk::GetFilePath(db_oid_, oid_);
+    if (!Disk::FileExists(path)) {
+      Disk::CreateFile(path);
+    }
+    // 崩溃恢复重做的页面可能只在缓存中；之前的最后一个页面可能未写满，从新的页面开始写入
+    pageid_t page_count = buffer_pool_.GetDisk().GetPageCount(db_oid_, oid_);
+    while (buffer_pool_.PageExists(db_oid_, oid_, page_count)) {
+      page_count++;
+    }
+    end_ = uint64_t{page_count} * payload_size_;
+    end_loaded_ = true;
+  }
+  if (end_ + data.size() > std::numeric_limits<uint32_t>::max()) {
+    throw DbException("Overflow file of table " + std::to_string(oid_ & ~OVERFLOW_OID_FLAG) + " is full");
+  }
+
+  uint32_t offset = end_;
+  // 每条日志中的数据不超过记录的最长长度，保证日志不超过 MAX_LOG_SIZE
+  size_t max_log_data_size = buffer_pool_.GetPageSize() - PAGE_RESERVED_SIZE;
+  size_t written = 0;
+  while (written < data.size()) {
+    pageid_t page_id = end_ / payload_size_;
+    db_size_t page_offset = OVERFLOW_PAGE_HEADER_SIZE + end_ % payload_size_;
+    db_size_t size = std::min({buffer_pool_.GetPageSize() - page_offset, data.size() - written, max_log_data_size});
+    auto page = page_offset == OVERFLOW_PAGE_HEADER_SIZE ? buffer_pool_.NewPage(db_oid_, oid_, page_id)
+                                                         : buffer_pool_.FetchPageWrite(db_oid_, oid_, page_id);
+    memcpy(page.GetData() + page_offset, data.data() + written, size);
+    if (write_log) {
+      auto lsn = log_manager_.AppendOverflowLog(oid_, page_id, page_offset, size, data.data() + written);
+      memcpy(page.GetData(), &lsn, sizeof(lsn));
+    }
+    page.SetDirty();
+    written += size;
+    end_ += size;
+  }
+  write_count_++;
+  if (use_compressed) {
+    compressed_count_++;
+  }
+
+  uint32_t stored_size = data.size();
+  uint32_t raw_size = value.size();
+  std::string pointer(EXTERNAL_POINTER_SIZE, '\0');
+  memcpy(pointer.data(), &offset, sizeof(offset));
+  memcpy(pointer.data() + sizeof(offset), &stored_size, sizeof(stored_size));
+  memcpy(pointer.data() + sizeof(offset) + sizeof(stored_size), &raw_size, sizeof(raw_size));
+  return pointer;
+}
+
+std::string OverflowStorage::Read(const std::string &pointer) const {
+  uint32_t offset, stored_size, raw_size;
+  memcpy(&offset, pointer.data(), sizeof(offset));
+  memcpy(&stored_size, pointer.data() + sizeof(offset), sizeof(stored_size));
+  memcpy(&raw_size, pointer.data() + sizeof(offset) + sizeof(stored_size), sizeof(raw_size));
+
+  std::string data(stored_size, '\0');
+  size_t done = 0;
+  while (done < stored_size) {
+    uint64_t position = uint64_t{offset} + done;
+    pageid_t page_id = position / payload_size_;
+    size_t page_offset = OVERFLOW_PAGE_HEADER_SIZE + position % payload_size_;
+    size_t size = std::min(buffer_pool_.GetPageSize() - page_offset, stored_size - done);
+    auto page = buffer_pool_.FetchPageRead(db_oid_, oid_, page_id);
+    memcpy(data.data() + done, page.GetData() + page_offset, size);
+    done += size;
+  }
+  read_count_++;
+  if (stored_size != raw_size) {
+    return Compression::LzDecompress(data.data(), stored_size, raw_size);
+  }
+  return data;
+}
+
+size_t OverflowStorage::GetWriteCount() const { return write_count_; }
+
+size_t OverflowStorage::GetCompressedCount() const { return compressed_count_; }
+
+size_t OverflowStorage::GetReadCount() const { return read_count_; }
+
+}  // namespace huadb
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "common/value.h"
+#include "log/log_manager.h"
+#include "storage/buffer_pool.h"
+
+namespace huadb {
+
+// 表的溢出存储（类似 PostgreSQL 的 TOAST），放不进一个页面的记录中较长的 VARCHAR 值保存在表的溢出文件中，
+// 记录中只保存溢出指针，查询访问该值时才读取
+// 溢出文件的页面按页面号顺序组成一条链，值依次追加写入，一个页面写满后接着写入下一个页面
+// 值可压缩时保存 LZ 压缩后的数据；写入的数据不再修改，值不再被引用后其空间不回收
+class OverflowStorage : public ExternalReader {
+ public:
+  // oid 和 db_oid 为表的 oid 和表所在数据库的 oid
+  OverflowStorage(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid);
+
+  // 写入值，返回溢出指针；write_log 为 false 时不写日志（系统表）
+  std::string Write(const std::string &value, bool write_log);
+  // 根据溢出指针读取值
+  std::string Read(const std::string &pointer) const override;
+
+  // 写入的值的数目、其中压缩存储的值的数目和读取的值的数目
+  size_t GetWriteCount() const;
+  size_t GetCompressedCount() const;
+  size_t GetReadCount() const;
+
+ private:
+  BufferPool &buffer_pool_;
+  LogManager &log_manager_;
+  oid_t oid_;  // 溢出文件的 oid，即表的 oid 加上 OVERFLOW_OID_FLAG
+  oid_t db_oid_;
+  size_t payload_size_;  // 每个溢出页面中存放数据的字节数
+
+  std::mutex mutex_;  // 保护 end_，写入的值互不交错
+  bool end_loaded_ = false;
+  uint64_t end_ = 0;  // 溢出数据的末尾，即下一个值写入的位置
+
+  std::atomic<size_t> write_count_ = 0;
+  std::atomic<size_t> compressed_count_ = 0;
+  mutable std::atomic<size_t> read_count_ = 0;
+};
+
+}  // namespace huadb
@@ -0,0 +1,440 @@
+#include "table/pax_page.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <set>
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+namespace {
+
+// 参考系编码的列的值统一转换为 int64_t
+int64_t GetInteger(const Value &value) {
+  return value.GetType() == Type::UINT ? value.GetValue<uint32_t>() : value.GetValue<int32_t>();
+}
+
+// 取值范围的上下界转换为参考系编码的列的差值范围，上下界不是数值时返回 false，该范围需解码后判断
+bool GetOffsetRange(const ScanRange &range, int64_t base, int64_t &min_offset, int64_t &max_offset) {
+  auto is_number = [](const Value &bound) { return bound.GetType() == Type::INT || bound.GetType() == Type::DOUBLE; };
+  auto to_double = [](const Value &bound) {
+    return bound.GetType() == Type::INT ? bound.GetValue<int32_t>() : bound.GetValue<double>();
+  };
+  if ((range.lower_.has_value() && !is_number(*range.lower_)) ||
+      (range.upper_.has_value() && !is_number(*range.upper_))) {
+    return false;
+  }
+  double lower = 0;
+  if (range.lower_.has_value()) {
+    auto bound = to_double(*range.lower_);
+    lower = std::clamp((range.lower_inclusive_ ? std::ceil(bound) : std::floor(bound) + 1) - base, 0.0,
+                       PAX_MAX_FOR_OFFSET + 1.0);
+  }
+  double upper = PAX_MAX_FOR_OFFSET;
+  if (range.upper_.has_value()) {
+    auto bound = to_double(*range.upper_);
+    upper = std::clamp((range.upper_inclusive_ ? std::floor(bound) : std::ceil(bound) - 1) - base, -1.0,
+                       static_cast<double>(PAX_MAX_FOR_OFFSET));
+  }
+  min_offset = static_cast<int64_t>(lower);
+  max_offset = static_cast<int64_t>(upper);
+  return true;
+}
+
+}  // namespace
+
+PaxPage::PaxPage(PageGuard page_guard, const ColumnList &column_list)
+    : page_(page_guard.GetPage()), column_list_(column_list) {
+  page_guard_ = std::move(page_guard);
+  page_data_ = page_->GetData();
+  page_lsn_ = reinterpret_cast<lsn_t *>(page_data_);
+  record_count_ = reinterpret_cast<db_size_t *>(page_data_ + sizeof(lsn_t));
+  encoded_ = reinterpret_cast<uint8_t *>(page_data_ + sizeof(lsn_t) + sizeof(db_size_t));
+  bitmap_size_ = (column_list.Length() + 7) / 8;
+  InitLayout();
+}
+
+db_size_t PaxPage::GetCapacity(const ColumnList &column_list, size_t page_size) {
+  return (page_size - PAX_PAGE_HEADER_SIZE) / GetRecordWidth(column_list);
+}
+
+db_size_t PaxPage::GetRecordWidth(const ColumnList &column_list) {
+  size_t width = RECORD_HEADER_SIZE + (column_list.Length() + 7) / 8;
+  for (const auto &column : column_list.GetColumns()) {
+    width += column.GetMaxSize() + (TypeUtil::IsString(column.GetType()) ? sizeof(db_size_t) : 0);
+  }
+  return std::min<size_t>(width, std::numeric_limits<db_size_t>::max());
+}
+
+bool PaxPage::CanInsert(const Record &record) const {
+  if (IsFull()) {
+    return false;
+  }
+  const auto &values = record.GetValues();
+  for (size_t i = 0; i < values.size(); i++) {
+    if (encodings_[i] == PaxEncoding::PLAIN || values[i].IsNull()) {
+      continue;
+    }
+    if (encodings_[i] == PaxEncoding::FRAME_OF_REFERENCE) {
+      auto offset = GetInteger(values[i]) - bases_[i];
+      if (offset < 0 || offset > PAX_MAX_FOR_OFFSET) {
+        return false;
+      }
+    } else if (!FindCode(i, values[i].GetValue<std::string>()).has_value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+slotid_t PaxPage::InsertRecord(const Record &record, xid_t xid, cid_t cid) {
+  assert(CanInsert(record));
+  slotid_t slot_id = *record_count_;
+  Record header;
+  header.SetXmin(xid);
+  header.SetCid(cid);
+  header.SerializeHeaderTo(page_data_ + headers_offset_ + slot_id * RECORD_HEADER_SIZE);
+  WriteRecord(slot_id, record);
+  (*record_count_)++;
+  page_->SetDirty();
+  return slot_id;
+}
+
+void PaxPage::DeleteRecord(slotid_t slot_id, xid_t xid) {
+  auto header = GetRecordHeader(slot_id);
+  header.SetXmax(xid);
+  header.SerializeHeaderTo(page_data_ + headers_offset_ + slot_id * RECORD_HEADER_SIZE);
+  page_->SetDirty();
+}
+
+void PaxPage::UndoDeleteRecord(slotid_t slot_id) {
+  auto header = GetRecordHeader(slot_id);
+  header.SetXmax(NULL_XID);
+  header.SerializeHeaderTo(page_data_ + headers_offset_ + slot_id * RECORD_HEADER_SIZE);
+  page_->SetDirty();
+}
+
+void PaxPage::RedoInsertRecord(slotid_t slot_id, const Record &record) {
+  record.SerializeHeaderTo(page_data_ + headers_offset_ + slot_id * RECORD_HEADER_SIZE);
+  WriteRecord(slot_id, record);
+  if (*record_count_ <= slot_id) {
+    *record_count_ = slot_id + 1;
+  }
+  page_->SetDirty();
+}
+
+Record PaxPage::GetRecordHeader(slotid_t slot_id) const {
+  Record header;
+  header.DeserializeHeaderFrom(page_data_ + headers_offset_ + slot_id * RECORD_HEADER_SIZE);
+  return header;
+}
+
+std::shared_ptr<Record> PaxPage::GetRecord(Rid rid, const std::vector<size_t> &column_ids) const {
+  std::vector<Value> values(column_list_.Length());
+  for (auto column_id : column_ids) {
+    if (!IsNull(rid.slot_id_, column_id)) {
+      values[column_id] = ReadValue(rid.slot_id_, column_id);
+    }
+  }
+  auto record = std::make_shared<Record>(std::move(values), rid);
+  record->DeserializeHeaderFrom(page_data_ + headers_offset_ + rid.slot_id_ * RECORD_HEADER_SIZE);
+  return record;
+}
+
+bool PaxPage::Compress() {
+  if (IsEncoded() || *record_count_ == 0) {
+    return false;
+  }
+  db_size_t record_count = *record_count_;
+  std::vector<size_t> column_ids(column_list_.Length());
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    column_ids[i] = i;
+  }
+  std::vector<std::shared_ptr<Record>> records;
+  for (slotid_t slot_id = 0; slot_id < record_count; slot_id++) {
+    records.push_back(GetRecord({NULL_PAGE_ID, slot_id}, column_ids));
+  }
+
+  // 按页面中已有的值选择每一列的编码，同时生成列目录
+  std::vector<char> directory;
+  auto append = [&directory](const void *data, size_t size) {
+    directory.insert(directory.end(), static_cast<const char *>(data), static_cast<const char *>(data) + size);
+  };
+  size_t width = RECORD_HEADER_SIZE + bitmap_size_;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    auto type = column_list_.GetColumn(i).GetType();
+    if (type == Type::INT || type == Type::UINT) {
+      std::optional<int64_t> min;
+      std::optional<int64_t> max;
+      for (const auto &record : records) {
+        const auto &value = record->GetValue(i);
+        if (!value.IsNull()) {
+          auto number = GetInteger(value);
+          min = std::min(min.value_or(number), number);
+          max = std::max(max.value_or(number), number);
+        }
+      }
+      if (!min.has_value() || *max - *min <= PAX_MAX_FOR_OFFSET) {
+        auto encoding = PaxEncoding::FRAME_OF_REFERENCE;
+        int64_t base = min.value_or(0);
+        append(&encoding, sizeof(encoding));
+        append(&base, sizeof(base));
+        width += sizeof(uint16_t);
+        continue;
+      }
+    } else if (TypeUtil::IsString(type)) {
+      std::set<std::string> distinct;
+      for (const auto &record : records) {
+        const auto &value = record->GetValue(i);
+        if (!value.IsNull()) {
+          distinct.insert(value.GetValue<std::string>());
+        }
+      }
+      // 字典需要节省空间才使用字典编码
+      size_t dictionary_size = sizeof(uint8_t) + distinct.size() * sizeof(db_size_t);
+      for (const auto &str : distinct) {
+        dictionary_size += sizeof(db_size_t) + str.size();
+      }
+      if (distinct.size() <= PAX_MAX_DICTIONARY_SIZE &&
+          dictionary_size + record_count * sizeof(uint8_t) < record_count * column_widths_[i]) {
+        auto encoding = PaxEncoding::DICTIONARY;
+        append(&encoding, sizeof(encoding));
+        auto count = static_cast<uint8_t>(distinct.size());
+        append(&count, sizeof(count));
+        db_size_t offset = PAX_PAGE_HEADER_SIZE + directory.size() + distinct.size() * sizeof(db_size_t);
+        for (const auto &str : distinct) {
+          append(&offset, sizeof(offset));
+          offset += sizeof(db_size_t) + str.size();
+        }
+        for (const auto &str : distinct) {
+          db_size_t size = str.size();
+          append(&size, sizeof(size));
+          append(str.data(), size);
+        }
+        width += sizeof(uint8_t);
+        continue;
+      }
+    }
+    auto encoding = PaxEncoding::PLAIN;
+    append(&encoding, sizeof(encoding));
+    width += column_widths_[i];
+  }
+  if (PAX_PAGE_HEADER_SIZE + directory.size() >= page_->GetSize() ||
+      (page_->GetSize() - PAX_PAGE_HEADER_SIZE - directory.size()) / width <= record_count) {
+    return false;
+  }
+
+  // 清空页面后写入列目录，按新的布局重新写入所有记录
+  memset(page_data_ + PAX_PAGE_HEADER_SIZE, 0, page_->GetSize() - PAX_PAGE_HEADER_SIZE);
+  memcpy(page_data_ + PAX_PAGE_HEADER_SIZE, directory.data(), directory.size());
+  *encoded_ = 1;
+  InitLayout();
+  for (slotid_t slot_id = 0; slot_id < record_count; slot_id++) {
+    records[slot_id]->SerializeHeaderTo(page_data_ + headers_offset_ + slot_id * RECORD_HEADER_SIZE);
+    WriteRecord(slot_id, *records[slot_id]);
+  }
+  page_->SetDirty();
+  return true;
+}
+
+bool PaxPage::IsEncoded() const { return *encoded_ != 0; }
+
+PaxFilter PaxPage::PrepareFilter(const std::vector<ScanRange> &ranges) const {
+  PaxFilter filter;
+  filter.encoded_ = IsEncoded();
+  for (const auto &range : ranges) {
+    auto &condition = filter.conditions_.emplace_back();
+    auto column_id = range.column_id_;
+    if (encodings_[column_id] == PaxEncoding::DICTIONARY) {
+      auto type = column_list_.GetColumn(column_id).GetType();
+      condition.encoding_ = PaxEncoding::DICTIONARY;
+      for (size_t code = 0; code < GetDictionarySize(column_id); code++) {
+        condition.codes_.push_back(range.Contains(Value(GetDictionaryEntry(column_id, code), type)));
+      }
+    } else if (encodings_[column_id] == PaxEncoding::FRAME_OF_REFERENCE &&
+               GetOffsetRange(range, bases_[column_id], condition.min_offset_, condition.max_offset_)) {
+      condition.encoding_ = PaxEncoding::FRAME_OF_REFERENCE;
+    }
+  }
+  return filter;
+}
+
+bool PaxPage::Matches(slotid_t slot_id, const std::vector<ScanRange> &ranges, const PaxFilter &filter) const {
+  for (size_t i = 0; i < ranges.size(); i++) {
+    auto column_id = ranges[i].column_id_;
+    // 空值与任何值比较的结果均不为真
+    if (IsNull(slot_id, column_id)) {
+      return false;
+    }
+    const auto &condition = filter.conditions_[i];
+    const char *data = page_data_ + minipages_[column_id] + slot_id * column_widths_[column_id];
+    if (condition.encoding_ == PaxEncoding::DICTIONARY) {
+      if (!condition.codes_[*reinterpret_cast<const uint8_t *>(data)]) {
+        return false;
+      }
+    } else if (condition.encoding_ == PaxEncoding::FRAME_OF_REFERENCE) {
+      uint16_t offset;
+      memcpy(&offset, data, sizeof(offset));
+      if (offset < condition.min_offset_ || offset > condition.max_offset_) {
+        return false;
+      }
+    } else if (!ranges[i].Contains(ReadValue(slot_id, column_id))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+db_size_t PaxPage::GetRecordCount() const { return *record_count_; }
+
+bool PaxPage::IsFull() const { return *record_count_ >= capacity_; }
+
+db_size_t PaxPage::GetFreeSpaceSize() const { return (capacity_ - *record_count_) * GetRecordWidth(column_list_); }
+
+lsn_t PaxPage::GetPageLSN() const { return *page_lsn_; }
+
+void PaxPage::SetPageLSN(lsn_t page_lsn) {
+  *page_lsn_ = page_lsn;
+  page_->SetDirty();
+}
+
+void PaxPage::InitLayout() {
+  encodings_.assign(column_list_.Length(), PaxEncoding::PLAIN);
+  bases_.assign(column_list_.Length(), 0);
+  dictionaries_.assign(column_list_.Length(), 0);
+  column_widths_.clear();
+  minipages_.clear();
+  db_size_t offset = PAX_PAGE_HEADER_SIZE;
+  size_t width = RECORD_HEADER_SIZE + bitmap_size_;
+  for (size_t i = 0; i < column_list_.Length(); i++) {
+    const auto &column = column_list_.GetColumn(i);
+    db_size_t column_width = column.GetMaxSize() + (TypeUtil::IsString(column.GetType()) ? sizeof(db_size_t) : 0);
+    if (IsEncoded()) {
+      memcpy(&encodings_[i], page_data_ + offset, sizeof(PaxEncoding));
+      offset += sizeof(PaxEncoding);
+      if (encodings_[i] == PaxEncoding::FRAME_OF_REFERENCE) {
+        memcpy(&bases_[i], page_data_ + offset, sizeof(int64_t));
+        offset += sizeof(int64_t);
+        column_width = sizeof(uint16_t);
+      } else if (encodings_[i] == PaxEncoding::DICTIONARY) {
+        // 字典的末尾为最后一个值的结尾
+        dictionaries_[i] = offset;
+        auto count = GetDictionarySize(i);
+        offset += sizeof(uint8_t) + count * sizeof(db_size_t);
+        if (count > 0) {
+          db_size_t last;
+          memcpy(&last, page_data_ + dictionaries_[i] + sizeof(uint8_t) + (count - 1) * sizeof(db_size_t),
+                 sizeof(last));
+          offset = last + sizeof(db_size_t) + GetDictionaryEntry(i, count - 1).size();
+        }
+        column_width = sizeof(uint8_t);
+      }
+    }
+    column_widths_.push_back(column_width);
+    width += column_width;
+  }
+  headers_offset_ = offset;
+  capacity_ = (page_->GetSize() - headers_offset_) / width;
+  offset += capacity_ * (RECORD_HEADER_SIZE + bitmap_size_);
+  for (auto column_width : column_widths_) {
+    minipages_.push_back(offset);
+    offset += capacity_ * column_width;
+  }
+}
+
+void PaxPage::WriteRecord(slotid_t slot_id, const Record &record) {
+  auto *null_bitmap = reinterpret_cast<uint8_t *>(page_data_ + headers_offset_ + capacity_ * RECORD_HEADER_SIZE) +
+                      slot_id * bitmap_size_;
+  memset(null_bitmap, 0, bitmap_size_);
+  const auto &values = record.GetValues();
+  for (size_t i = 0; i < values.size(); i++) {
+    if (values[i].IsNull()) {
+      null_bitmap[i / 8] |= 1 << (i % 8);
+      continue;
+    }
+    char *data = page_data_ + minipages_[i] + slot_id * column_widths_[i];
+    if (encodings_[i] == PaxEncoding::FRAME_OF_REFERENCE) {
+      auto offset = static_cast<uint16_t>(GetInteger(values[i]) - bases_[i]);
+      memcpy(data, &offset, sizeof(offset));
+      continue;
+    }
+    if (encodings_[i] == PaxEncoding::DICTIONARY) {
+      auto code = FindCode(i, values[i].GetValue<std::string>());
+      assert(code.has_value());
+      memcpy(data, &*code, sizeof(uint8_t));
+      continue;
+    }
+    if (!TypeUtil::IsString(values[i].GetType())) {
+      values[i].SerializeTo(data);
+      continue;
+    }
+    // 行外存储的值先读出，列存页面中只保存完整的值
+    auto str = values[i].GetValue<std::string>();
+    if (str.size() + sizeof(db_size_t) > column_widths_[i]) {
+      throw DbException("Value too long for column " + column_list_.GetColumn(i).GetName());
+    }
+    db_size_t size = str.size();
+    memcpy(data, &size, sizeof(size));
+    memcpy(data + sizeof(size), str.data(), size);
+  }
+}
+
+bool PaxPage::IsNull(slotid_t slot_id, size_t column_id) const {
+  const auto *null_bitmap =
+      reinterpret_cast<const uint8_t *>(page_data_ + headers_offset_ + capacity_ * RECORD_HEADER_SIZE) +
+      slot_id * bitmap_size_;
+  return (null_bitmap[column_id / 8] & (1 << (column_id % 8))) != 0;
+}
+
+Value PaxPage::ReadValue(slotid_t slot_id, size_t column_id) const {
+  const auto &column = column_list_.GetColumn(column_id);
+  const char *data = page_data_ + minipages_[column_id] + slot_id * column_widths_[column_id];
+  if (encodings_[column_id] == PaxEncoding::FRAME_OF_REFERENCE) {
+    uint16_t offset;
+    memcpy(&offset, data, sizeof(offset));
+    auto number = bases_[column_id] + offset;
+    return column.GetType() == Type::UINT ? Value(static_cast<uint32_t>(number)) : Value(static_cast<int32_t>(number));
+  }
+  if (encodings_[column_id] == PaxEncoding::DICTIONARY) {
+    return Value(GetDictionaryEntry(column_id, *reinterpret_cast<const uint8_t *>(data)), column.GetType());
+  }
+  Value value(column.GetType(), column.GetMaxSize());
+  value.DeserializeFrom(data);
+  return value;
+}
+
+size_t PaxPage::GetDictionarySize(size_t column_id) const {
+  return *reinterpret_cast<const uint8_t *>(page_data_ + dictionaries_[column_id]);
+}
+
+std::string PaxPage::GetDictionaryEntry(size_t column_id, size_t code) const {
+  db_size_t offset;
+  memcpy(&offset, page_data_ + dictionaries_[column_id] + sizeof(uint8_t) + code * sizeof(db_size_t), sizeof(offset));
+  db_size_t size;
+  memcpy(&size, page_data_ + offset, sizeof(size));
+  return std::string(page_data_ + offset + sizeof(size), size);
+}
+
+std::optional<uint8_t> PaxPage::FindCode(size_t column_id, const std::string &str) const {
+  size_t low = 0;
+  size_t high = GetDictionarySize(column_id);
+  while (low < high) {
+    auto middle = (low + high) / 2;
+    auto entry = GetDictionaryEntry(column_id, middle);
+    if (entry == str) {
+      return middle;
+    }
+    if (entry < str) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace huadb
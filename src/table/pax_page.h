@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "catalog/column_list.h"
+#include "common/types.h"
+#include "storage/page.h"
+#include "storage/page_guard.h"
+#include "table/record.h"
+#include "table/zone_map.h"
+
+namespace huadb {
+
+// page_lsn(8) + record_count(2) + encoded(1) = 11
+static constexpr db_size_t PAX_PAGE_HEADER_SIZE = sizeof(lsn_t) + sizeof(db_size_t) + sizeof(uint8_t);
+// 参考系编码的列中值与基准值之差的上限，差值占 2 字节
+static constexpr int64_t PAX_MAX_FOR_OFFSET = UINT16_MAX;
+// 字典编码的列的字典最多包含的值数目，编码占 1 字节
+static constexpr size_t PAX_MAX_DICTIONARY_SIZE = UINT8_MAX;
+
+// 压缩页面中列的编码方式
+enum class PaxEncoding : uint8_t {
+  PLAIN,               // 不压缩，与未压缩页面相同
+  FRAME_OF_REFERENCE,  // INT 和 UINT 列，存储值与页面中该列最小值的差
+  DICTIONARY,          // CHAR 和 VARCHAR 列，存储值在页面字典中的编号，字典按字典序排列
+};
+
+// 为某个页面准备的取值范围判断，由 PaxPage::PrepareFilter 生成
+// 压缩的列直接比较编码：字典编码的列预先计算每个编号是否满足条件，参考系编码的列将取值范围转换为差值的范围
+struct PaxFilter {
+  struct Condition {
+    PaxEncoding encoding_ = PaxEncoding::PLAIN;
+    std::vector<bool> codes_;  // 字典编码的列中每个编号对应的值是否满足条件
+    int64_t min_offset_ = 0;   // 参考系编码的列中满足条件的差值的闭区间
+    int64_t max_offset_ = -1;
+  };
+  bool encoded_ = false;               // 准备时页面是否已压缩，页面之后被压缩时需重新准备
+  std::vector<Condition> conditions_;  // 与取值范围一一对应
+};
+
+// 列存表的 PAX（Partition Attributes Across）页面
+// 页面中的记录按列划分，同一列的值连续存放在该列的小页（minipage）中，扫描只需解码查询用到的列
+// 页面格式：| page_lsn | record_count | encoded | 列目录 | 记录头小页 | 空值位图小页 | 第 0 列小页 | ... |
+// 每个小页为定长槽位数组，槽位数目即页面容量，由表的 schema、页面大小和列的编码决定
+// 未压缩页面没有列目录，定长列的槽位为类型的长度，CHAR 和 VARCHAR 列的槽位为 2 字节长度加上列的最大长度
+// 压缩页面的列目录依次记录每一列的编码，参考系编码的列之后为 8 字节基准值，字典编码的列之后为字典：
+// | 值数目(1) | 每个值的偏移(2) ... | 每个值的长度(2) 和内容 ... |，参考系编码的槽位为 2 字节，字典编码的槽位为 1 字节
+// 记录依次追加到页面中，删除只设置记录头的 xmax，槽位不回收
+// 页面接近写满时可压缩，压缩根据页面中已有的值选择编码并原地重写页面，槽号不变；压缩后字典和基准值不再改变，
+// 无法用页面的编码表示的记录不能插入该页面
+class PaxPage {
+ public:
+  // 通过页面守卫构造，PaxPage 存在期间页面保持 pin 住
+  PaxPage(PageGuard page_guard, const ColumnList &column_list);
+
+  // 每个页面可容纳的记录数目，为 0 时表示记录过长，表无法按列存储
+  static db_size_t GetCapacity(const ColumnList &column_list, size_t page_size);
+  // 记录在页面中占用的字节数，用于空闲空间映射
+  static db_size_t GetRecordWidth(const ColumnList &column_list);
+
+  // 页面是否可以插入记录，即页面未满，且页面已压缩时记录的值可以用页面的编码表示
+  bool CanInsert(const Record &record) const;
+  // 在页面末尾插入记录，返回插入的槽号，调用者需保证 CanInsert 为真
+  slotid_t InsertRecord(const Record &record, xid_t xid, cid_t cid);
+  // 删除记录，即设置记录的 xmax
+  void DeleteRecord(slotid_t slot_id, xid_t xid);
+  // 回滚删除操作，清除记录的 xmax
+  void UndoDeleteRecord(slotid_t slot_id);
+  // 重做插入操作，record 包含插入时的记录头
+  void RedoInsertRecord(slotid_t slot_id, const Record &record);
+
+  // 获取记录头，返回的记录不包含列的值，用于判断可见性
+  Record GetRecordHeader(slotid_t slot_id) const;
+  // 获取记录，只解码 column_ids 中的列，其余列的值为空
+  std::shared_ptr<Record> GetRecord(Rid rid, const std::vector<size_t> &column_ids) const;
+
+  // 按页面中已有的值为每一列选择编码并原地重写页面，压缩后容量大于记录数目时才压缩
+  // 结果只取决于页面内容，重做时对相同的页面再次压缩得到相同的结果；返回是否压缩了页面
+  bool Compress();
+  // 页面是否已压缩
+  bool IsEncoded() const;
+  // 为页面准备取值范围的判断，页面压缩后需重新准备
+  PaxFilter PrepareFilter(const std::vector<ScanRange> &ranges) const;
+  // 槽位 slot_id 的记录是否满足所有取值范围，filter 由 PrepareFilter 以相同的 ranges 生成
+  bool Matches(slotid_t slot_id, const std::vector<ScanRange> &ranges, const PaxFilter &filter) const;
+
+  // 获取记录数目
+  db_size_t GetRecordCount() const;
+  // 页面是否已满
+  bool IsFull() const;
+  // 获取页面剩余空间大小，即剩余槽位数目乘以记录占用的字节数
+  db_size_t GetFreeSpaceSize() const;
+  lsn_t GetPageLSN() const;
+  void SetPageLSN(lsn_t page_lsn);
+
+ private:
+  // 根据页面头和列目录计算页面容量和各小页的偏移
+  void InitLayout();
+  // 将记录写入槽位 slot_id
+  void WriteRecord(slotid_t slot_id, const Record &record);
+  // 槽位 slot_id 的记录在第 column_id 列的值是否为空
+  bool IsNull(slotid_t slot_id, size_t column_id) const;
+  // 解码槽位 slot_id 的记录在第 column_id 列的值，调用者需保证值不为空
+  Value ReadValue(slotid_t slot_id, size_t column_id) const;
+  // 字典编码的第 column_id 列的字典中的值数目和编号为 code 的值
+  size_t GetDictionarySize(size_t column_id) const;
+  std::string GetDictionaryEntry(size_t column_id, size_t code) const;
+  // 在字典中二分查找值的编号，值不在字典中时返回空
+  std::optional<uint8_t> FindCode(size_t column_id, const std::string &str) const;
+
+  PageGuard page_guard_;
+  Page *page_;
+  char *page_data_;
+  lsn_t *page_lsn_;
+  db_size_t *record_count_;
+  uint8_t *encoded_;
+  const ColumnList &column_list_;
+  db_size_t capacity_;
+  db_size_t bitmap_size_;                 // 每条记录的空值位图字节数
+  db_size_t headers_offset_;              // 记录头小页在页面中的偏移，即列目录之后
+  std::vector<PaxEncoding> encodings_;    // 每一列的编码，未压缩页面均为 PLAIN
+  std::vector<int64_t> bases_;            // 参考系编码的列的基准值
+  std::vector<db_size_t> dictionaries_;   // 字典编码的列的字典在页面中的偏移
+  std::vector<db_size_t> column_widths_;  // 每一列的槽位长度
+  std::vector<db_size_t> minipages_;      // 每一列的小页在页面中的偏移
+};
+
+}  // namespace huadb
@@ -83,6 +83,9 @@ db_size_t Record::DeserializeFrom(const char *data, const ColumnList &column_lis
     } else {
       auto value = Value(columns[i].type_, columns[i].max_size_);
       offset += value.DeserializeFrom(data + offset);
+      if (value.IsExternal()) {
+        value.SetExternalReader(column_list.GetExternalReader());
+      }
       values_.push_back(value);
     }
   }
@@ -0,0 +1,67 @@
+#include "table/record_view.h"
+
+#include <cstring>
+
+#include "common/constants.h"
+#include "common/type_util.h"
+#include "table/record_header.h"
+
+namespace huadb {
+
+void RecordView::Reset(const char *data, const ColumnList &column_list, Rid rid) {
+  data_ = data;
+  column_list_ = &column_list;
+  rid_ = rid;
+  values_offset_ = RECORD_HEADER_SIZE + (column_list.Length() + 7) / 8;
+  offsets_.clear();
+  offsets_.push_back(values_offset_);
+}
+
+Record RecordView::GetHeader() const {
+  Record header;
+  header.DeserializeHeaderFrom(data_);
+  header.SetRid(rid_);
+  return header;
+}
+
+bool RecordView::IsNull(size_t col_idx) const {
+  auto bits = static_cast<uint8_t>(data_[RECORD_HEADER_SIZE + col_idx / 8]);
+  return (bits & (1U << (col_idx % 8))) != 0;
+}
+
+Value RecordView::GetValue(size_t col_idx) const {
+  if (IsNull(col_idx)) {
+    return Value();
+  }
+  const auto &column = column_list_->GetColumn(col_idx);
+  auto value = Value(column.GetType(), column.GetMaxSize());
+  value.DeserializeFrom(data_ + GetOffset(col_idx));
+  if (value.IsExternal()) {
+    value.SetExternalReader(column_list_->GetExternalReader());
+  }
+  return value;
+}
+
+Rid RecordView::GetRid() const { return rid_; }
+
+db_size_t RecordView::GetOffset(size_t col_idx) const {
+  // 由最后一个已知偏移的列的值的大小推出下一列的偏移，与 Value::DeserializeFrom 读取的字节数一致
+  while (offsets_.size() <= col_idx) {
+    size_t i = offsets_.size() - 1;
+    auto offset = offsets_.back();
+    if (!IsNull(i)) {
+      const auto &column = column_list_->GetColumn(i);
+      if (TypeUtil::IsString(column.GetType())) {
+        db_size_t size = 0;
+        memcpy(&size, data_ + offset, 2);
+        offset += 2 + ((size & EXTERNAL_VALUE_FLAG) != 0 ? EXTERNAL_POINTER_SIZE : size);
+      } else {
+        offset += column.GetMaxSize();
+      }
+    }
+    offsets_.push_back(offset);
+  }
+  return offsets_[col_idx];
+}
+
+}  // namespace huadb
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "catalog/column_list.h"
+#include "common/types.h"
+#include "common/value.h"
+#include "table/record.h"
+
+namespace huadb {
+
+// 页面中序列化记录的只读视图，不复制记录的数据
+// 各列在记录中的偏移在访问时才按顺序计算并缓存，值也只在访问时构造，未访问的列不解码
+// 视图不持有页面，只在记录所在页面被 pin 住期间有效。扫描在页面中逐条记录复用同一视图，重置时不分配内存
+class RecordView {
+ public:
+  // 将视图指向从 data 开始的序列化记录，清空已缓存的偏移
+  void Reset(const char *data, const ColumnList &column_list, Rid rid);
+
+  // 只包含记录头的记录，用于判断可见性
+  Record GetHeader() const;
+  // 第 col_idx 列是否为空值
+  bool IsNull(size_t col_idx) const;
+  // 构造第 col_idx 列的值，行外存储的值只构造溢出指针，首次访问其内容时才读取
+  Value GetValue(size_t col_idx) const;
+  Rid GetRid() const;
+
+ private:
+  // 第 col_idx 列的值在记录中的偏移，从最后一个已知偏移的列依次计算到该列为止
+  db_size_t GetOffset(size_t col_idx) const;
+
+  const char *data_ = nullptr;
+  const ColumnList *column_list_ = nullptr;
+  Rid rid_;
+  db_size_t values_offset_ = 0;             // 第一个值的偏移，即记录头与空值位图的大小
+  mutable std::vector<db_size_t> offsets_;  // offsets_[i] 为第 i 列的值的偏移（空值列为下一个值的偏移）
+};
+
+}  // namespace huadb
@@ -1,27 +1,80 @@
 #include "table/table.h"
 
+#include <numeric>
+#include <optional>
+
+#include "table/pax_page.h"
 #include "table/table_page.h"
 
 namespace huadb {
 
+namespace {
+
+// 页面中所有未回收的记录，包括已删除但尚未被 VACUUM 回收的版本
+std::vector<std::shared_ptr<Record>> GetPageRecords(TablePage &table_page, pageid_t page_id,
+                                                    const ColumnList &column_list) {
+  std::vector<std::shared_ptr<Record>> records;
+  for (slotid_t slot_id = 0; slot_id < table_page.GetRecordCount(); slot_id++) {
+    if (!table_page.IsSlotUnused(slot_id)) {
+      records.push_back(table_page.GetRecord({page_id, slot_id}, column_list));
+    }
+  }
+  return records;
+}
+
+}  // namespace
+
 Table::Table(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, ColumnList column_list,
-             bool new_table, bool is_empty)
+             bool new_table, bool is_empty, StorageType storage_type)
     : buffer_pool_(buffer_pool),
       log_manager_(log_manager),
       oid_(oid),
       db_oid_(db_oid),
-      column_list_(std::move(column_list)) {
+      column_list_(std::move(column_list)),
+      storage_type_(storage_type),
+      fsm_(db_oid, oid, buffer_pool.GetPageSize()),
+      vm_(db_oid, oid),
+      zone_map_(db_oid, oid, column_list_),
+      overflow_(std::make_shared<OverflowStorage>(buffer_pool, log_manager, oid, db_oid)) {
+  column_list_.SetExternalReader(overflow_);
   if (new_table || is_empty) {
     first_page_id_ = NULL_PAGE_ID;
   } else {
     first_page_id_ = 0;
   }
+  // 系统表不执行 VACUUM，其页面不会被标记为全可见
+  if (db_oid_ != SYSTEM_DATABASE_OID) {
+    vm_.Load();
+  }
 }
 
-Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bool write_log) {
-  if (record->GetSize() > MAX_RECORD_SIZE) {
-    throw DbException("Record size too large: " + std::to_string(record->GetSize()));
+Table::~Table() {
+  // 系统表不写日志，崩溃后可能丢失未写回的页面，其映射不保存，每次启动时重建
+  if (db_oid_ != SYSTEM_DATABASE_OID) {
+    fsm_.Save();
+    vm_.Save();
+    zone_map_.Save();
   }
+}
+
+Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bool write_log, BufferRing *ring) {
+  LoadZoneMap();
+  Rid rid;
+  if (storage_type_ != StorageType::ROW) {
+    rid = InsertColumnarRecord(*record, xid, cid, write_log, ring);
+  } else {
+    StoreExternalValues(*record, write_log);
+    rid = InsertRowRecord(record, xid, cid, write_log, ring);
+  }
+  // 记录插入页面后才扩展上下界，其间扫描该页面的其他事务看不到尚未提交的新记录，不影响结果
+  if (db_oid_ != SYSTEM_DATABASE_OID) {
+    zone_map_.Update(rid.page_id_, *record);
+  }
+  return rid;
+}
+
+Rid Table::InsertRowRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bool write_log, BufferRing *ring) {
+  LoadFreeSpaceMap();
 
   // 当 write_log 参数为 true 时开启写日志功能
   // 在插入记录时增加写 InsertLog 过程
@@ -29,39 +82,340 @@ Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bo
   // 设置页面的 page lsn
   // LAB 2 BEGIN
 
-  // 使用 buffer_pool_ 获取页面
-  // 使用 TablePage 类操作记录页面
-  // 遍历表的页面，判断页面是否有足够的空间插入记录，如果没有则通过 buffer_pool_ 创建新页面
-  // 如果 first_page_id_ 为 NULL_PAGE_ID，说明表还没有页面，需要创建新页面
-  // 创建新页面时需设置前一个页面的 next_page_id，并将新页面初始化
-  // 找到空间足够的页面后，通过 TablePage 插入记录
-  // 返回插入记录的 rid
-  // LAB 1 BEGIN
-  return {0, 0};
+  auto size = record->GetSize();
+  pageid_t page_id;
+  std::unique_ptr<TablePage> table_page;
+  while ((page_id = fsm_.FindPage(size)) != NULL_PAGE_ID) {
+    table_page = std::make_unique<TablePage>(buffer_pool_.FetchPageWrite(db_oid_, oid_, page_id, ring));
+    if (table_page->GetFreeSpaceSize() >= size) {
+      break;
+    }
+    fsm_.Update(page_id, table_page->GetFreeSpaceSize());
+    table_page.reset();
+  }
+  if (page_id == NULL_PAGE_ID) {
+    page_id = fsm_.AddPage();
+    pageid_t prev = page_id == 0 ? NULL_PAGE_ID : page_id - 1;
+    if (prev == NULL_PAGE_ID) {
+      first_page_id_ = page_id;
+    } else {
+      TablePage(buffer_pool_.FetchPageWrite(db_oid_, oid_, prev, ring)).SetNextPageId(page_id);
+    }
+    table_page = std::make_unique<TablePage>(buffer_pool_.NewPage(db_oid_, oid_, page_id, ring));
+    table_page->Init();
+    if (write_log) {
+      auto lsn = log_manager_.AppendNewPageLog(xid, oid_, prev, page_id);
+      table_page->SetPageLSN(lsn);
+      if (prev != NULL_PAGE_ID) {
+        TablePage(buffer_pool_.FetchPageWrite(db_oid_, oid_, prev, ring)).SetPageLSN(lsn);
+      }
+    }
+  }
+  vm_.Clear(page_id);
+  auto slot_id = table_page->InsertRecord(record, xid, cid);
+  if (write_log) {
+    auto buf = std::make_unique<char[]>(size);
+    record->SerializeTo(buf.get());
+    auto lsn = log_manager_.AppendInsertLog(xid, oid_, page_id, slot_id, table_page->GetUpper(), size, buf.get());
+    table_page->SetPageLSN(lsn);
+  }
+  fsm_.Update(page_id, table_page->GetFreeSpaceSize());
+  return {page_id, slot_id};
 }
 
 void Table::DeleteRecord(const Rid &rid, xid_t xid, bool write_log) {
+  if (storage_type_ != StorageType::ROW) {
+    DeleteColumnarRecord(rid, xid, write_log);
+    return;
+  }
+  // 被删除记录所在的页面不再全可见
+  vm_.Clear(rid.page_id_);
+
   // 增加写 DeleteLog 过程
   // 设置页面的 page lsn
   // LAB 2 BEGIN
 
-  // 使用 TablePage 操作页面
-  // LAB 1 BEGIN
+  auto table_page = std::make_unique<TablePage>(buffer_pool_.FetchPageWrite(db_oid_, oid_, rid.page_id_));
+  table_page->DeleteRecord(rid.slot_id_, xid);
+  if (write_log) {
+    table_page->SetPageLSN(log_manager_.AppendDeleteLog(xid, oid_, rid.page_id_, rid.slot_id_));
+  }
 }
 
-Rid Table::UpdateRecord(const Rid &rid, xid_t xid, cid_t cid, std::shared_ptr<Record> record, bool write_log) {
+Rid Table::UpdateRecord(const Rid &rid, xid_t xid, cid_t cid, std::shared_ptr<Record> record, bool write_log,
+                        xid_t oldest_xmin) {
+  // 列存表的槽位不回收，更新即删除旧版本并追加新版本
+  if (storage_type_ != StorageType::ROW) {
+    DeleteColumnarRecord(rid, xid, write_log);
+    return InsertRecord(std::move(record), xid, cid, write_log);
+  }
+  StoreExternalValues(*record, write_log);
+  LoadFreeSpaceMap();
+  LoadZoneMap();
+  auto size = record->GetSize();
+  {
+    TablePage table_page(buffer_pool_.FetchPageWrite(db_oid_, oid_, rid.page_id_));
+    // 回收的旧版本对所有事务都不可见，其中不包括当前要更新的版本
+    if (table_page.GetFreeSpaceSize() < size && table_page.Vacuum(oldest_xmin) > 0 && write_log) {
+      table_page.SetPageLSN(log_manager_.AppendVacuumLog(oid_, rid.page_id_, oldest_xmin));
+    }
+    if (table_page.GetFreeSpaceSize() >= size) {
+      vm_.Clear(rid.page_id_);
+      table_page.DeleteRecord(rid.slot_id_, xid);
+      auto slot_id = table_page.MoveToUnusedSlot(table_page.InsertRecord(record, xid, cid));
+      if (write_log) {
+        auto buf = std::make_unique<char[]>(size);
+        record->SerializeTo(buf.get());
+        auto lsn = log_manager_.AppendUpdateLog(xid, oid_, rid.page_id_, rid.slot_id_, slot_id, table_page.GetUpper(),
+                                                size, buf.get());
+        table_page.SetPageLSN(lsn);
+      }
+      fsm_.Update(rid.page_id_, table_page.GetFreeSpaceSize());
+      zone_map_.Update(rid.page_id_, *record);
+      hot_update_count_++;
+      return {rid.page_id_, slot_id};
+    }
+    fsm_.Update(rid.page_id_, table_page.GetFreeSpaceSize());
+  }
   DeleteRecord(rid, xid, write_log);
   return InsertRecord(record, xid, cid, write_log);
 }
 
 void Table::UpdateRecordInPlace(const Record &record) {
   auto rid = record.GetRid();
-  auto table_page = std::make_unique<TablePage>(buffer_pool_.GetPage(db_oid_, oid_, rid.page_id_));
+  auto table_page = std::make_unique<TablePage>(buffer_pool_.FetchPageWrite(db_oid_, oid_, rid.page_id_));
   table_page->UpdateRecordInPlace(record, rid.slot_id_);
 }
 
+VacuumResult Table::Vacuum(xid_t oldest_xmin) {
+  VacuumResult result;
+  // 列存表的槽位不回收，只能通过重建表回收空间
+  if (first_page_id_ == NULL_PAGE_ID || storage_type_ != StorageType::ROW) {
+    return result;
+  }
+  LoadFreeSpaceMap();
+  LoadZoneMap();
+  // 表的页面号连续，链表顺序即页面号顺序
+  pageid_t last_page_id = first_page_id_;
+  pageid_t last_used_page_id = first_page_id_;
+  {
+    // 大表通过页帧环访问页面，避免 VACUUM 挤出缓存中的其他页面
+    auto ring = buffer_pool_.CreateBulkReadRing(db_oid_, oid_);
+    pageid_t page_id = first_page_id_;
+    while (page_id != NULL_PAGE_ID) {
+      TablePage table_page(buffer_pool_.FetchPageWrite(db_oid_, oid_, page_id, ring.get()));
+      auto removed = table_page.Vacuum(oldest_xmin);
+      if (removed > 0) {
+        table_page.SetPageLSN(log_manager_.AppendVacuumLog(oid_, page_id, oldest_xmin));
+        fsm_.Update(page_id, table_page.GetFreeSpaceSize());
+        // 回收的记录不再计入上下界，持有页面的写锁，重新计算期间页面不会插入新记录
+        zone_map_.Reset(page_id, GetPageRecords(table_page, page_id, column_list_));
+        result.removed_count_ += removed;
+      }
+      if (table_page.IsAllVisible(oldest_xmin)) {
+        vm_.SetAllVisible(page_id);
+        result.all_visible_count_++;
+      }
+      if (!table_page.IsEmpty()) {
+        last_used_page_id = page_id;
+      }
+      last_page_id = page_id;
+      page_id = table_page.GetNextPageId();
+    }
+  }
+  if (last_used_page_id == last_page_id) {
+    return result;
+  }
+  auto lsn = log_manager_.AppendTruncateLog(oid_, last_used_page_id + 1);
+  {
+    TablePage last_page(buffer_pool_.FetchPageWrite(db_oid_, oid_, last_used_page_id));
+    last_page.SetNextPageId(NULL_PAGE_ID);
+    last_page.SetPageLSN(lsn);
+  }
+  // 截断文件前日志需已刷盘，否则故障后磁盘上最后一个页面的 next_page_id 仍指向已被截断的页面
+  log_manager_.Flush();
+  buffer_pool_.TruncateFile(db_oid_, oid_, last_used_page_id + 1);
+  fsm_.Truncate(last_used_page_id + 1);
+  vm_.Truncate(last_used_page_id + 1);
+  zone_map_.Truncate(last_used_page_id + 1);
+  result.truncated_count_ = last_page_id - last_used_page_id;
+  return result;
+}
+
+StorageType Table::GetStorageType() const { return storage_type_; }
+
+size_t Table::GetPageCount() {
+  LoadFreeSpaceMap();
+  return fsm_.GetPageCount();
+}
+
+size_t Table::GetHotUpdateCount() const { return hot_update_count_; }
+
+size_t Table::GetZoneMapSkipCount() const { return zone_map_skip_count_; }
+
+size_t Table::GetCompressedPageCount() const { return compressed_page_count_; }
+
+const OverflowStorage &Table::GetOverflowStorage() const { return *overflow_; }
+
 pageid_t Table::GetFirstPageId() const { return first_page_id_; }
 
+bool Table::IsAllVisible(pageid_t page_id) const { return vm_.IsAllVisible(page_id); }
+
+bool Table::PageMayMatch(pageid_t page_id, const std::vector<ScanRange> &ranges) {
+  if (ranges.empty() || db_oid_ == SYSTEM_DATABASE_OID) {
+    return true;
+  }
+  LoadZoneMap();
+  if (zone_map_.MayMatch(page_id, ranges)) {
+    return true;
+  }
+  zone_map_skip_count_++;
+  return false;
+}
+
+void Table::LoadFreeSpaceMap() {
+  std::call_once(fsm_loaded_, [this]() {
+    // 列存表的页面之间没有链表，依次读取页面号连续的页面直到文件末尾
+    if (storage_type_ != StorageType::ROW) {
+      pageid_t page_id = fsm_.Load() ? fsm_.GetPageCount() : 0;
+      for (; first_page_id_ != NULL_PAGE_ID && buffer_pool_.PageExists(db_oid_, oid_, page_id); page_id++) {
+        PaxPage pax_page(buffer_pool_.FetchPageRead(db_oid_, oid_, page_id), column_list_);
+        fsm_.Update(page_id, pax_page.GetFreeSpaceSize());
+      }
+      return;
+    }
+    pageid_t page_id = first_page_id_;
+    if (fsm_.Load() && fsm_.GetPageCount() > 0) {
+      auto last_page = TablePage(buffer_pool_.FetchPageRead(db_oid_, oid_, fsm_.GetPageCount() - 1));
+      page_id = last_page.GetNextPageId();
+    }
+    while (page_id != NULL_PAGE_ID) {
+      auto table_page = TablePage(buffer_pool_.FetchPageRead(db_oid_, oid_, page_id));
+      fsm_.Update(page_id, table_page.GetFreeSpaceSize());
+      page_id = table_page.GetNextPageId();
+    }
+  });
+}
+
+void Table::LoadZoneMap() {
+  if (db_oid_ == SYSTEM_DATABASE_OID || !zone_map_.HasColumns()) {
+    return;
+  }
+  std::call_once(zone_map_loaded_, [this]() {
+    if (zone_map_.Load() || first_page_id_ == NULL_PAGE_ID) {
+      return;
+    }
+    // 表的页面号连续，依次计算每个页面的上下界
+    LoadFreeSpaceMap();
+    auto ring = buffer_pool_.CreateBulkReadRing(db_oid_, oid_);
+    for (pageid_t page_id = 0; page_id < fsm_.GetPageCount(); page_id++) {
+      auto page_guard = buffer_pool_.FetchPageRead(db_oid_, oid_, page_id, ring.get());
+      std::vector<std::shared_ptr<Record>> records;
+      if (storage_type_ != StorageType::ROW) {
+        PaxPage pax_page(std::move(page_guard), column_list_);
+        std::vector<size_t> column_ids(column_list_.Length());
+        std::iota(column_ids.begin(), column_ids.end(), 0);
+        for (slotid_t slot_id = 0; slot_id < pax_page.GetRecordCount(); slot_id++) {
+          records.push_back(pax_page.GetRecord({page_id, slot_id}, column_ids));
+        }
+      } else {
+        TablePage table_page(std::move(page_guard));
+        records = GetPageRecords(table_page, page_id, column_list_);
+      }
+      zone_map_.Reset(page_id, records);
+    }
+  });
+}
+
+Rid Table::InsertColumnarRecord(const Record &record, xid_t xid, cid_t cid, bool write_log, BufferRing *ring) {
+  LoadFreeSpaceMap();
+  auto width = PaxPage::GetRecordWidth(column_list_);
+  pageid_t page_id;
+  std::unique_ptr<PaxPage> pax_page;
+  while ((page_id = fsm_.FindPage(width)) != NULL_PAGE_ID) {
+    pax_page = std::make_unique<PaxPage>(buffer_pool_.FetchPageWrite(db_oid_, oid_, page_id, ring), column_list_);
+    if (pax_page->CanInsert(record)) {
+      break;
+    }
+    // 页面已满，或页面已压缩且记录的值无法用页面的编码表示，不再向该页面插入
+    fsm_.Update(page_id, 0);
+    pax_page.reset();
+  }
+  // 压缩表需要新页面时先压缩最后一个页面，压缩后能容纳记录则插入该页面
+  // 以表增长作为压缩时机，不依赖空闲空间映射的精度，页面的最后几个槽位未被使用时同样会压缩
+  if (page_id == NULL_PAGE_ID && storage_type_ == StorageType::COMPRESSED_COLUMNAR && fsm_.GetPageCount() > 0) {
+    pageid_t last_page_id = fsm_.GetPageCount() - 1;
+    pax_page = std::make_unique<PaxPage>(buffer_pool_.FetchPageWrite(db_oid_, oid_, last_page_id, ring), column_list_);
+    if (pax_page->Compress()) {
+      if (write_log) {
+        pax_page->SetPageLSN(log_manager_.AppendPaxCompressLog(oid_, last_page_id));
+      }
+      compressed_page_count_++;
+    }
+    if (pax_page->CanInsert(record)) {
+      page_id = last_page_id;
+    } else {
+      fsm_.Update(last_page_id, 0);
+      pax_page.reset();
+    }
+  }
+  // 新页面内容全为 0，即没有记录的 PAX 页面，重做插入时页面不存在则新建，因此无需 NewPageLog
+  if (page_id == NULL_PAGE_ID) {
+    page_id = fsm_.AddPage();
+    pax_page = std::make_unique<PaxPage>(buffer_pool_.NewPage(db_oid_, oid_, page_id, ring), column_list_);
+    first_page_id_ = 0;
+  }
+  auto slot_id = pax_page->InsertRecord(record, xid, cid);
+  if (write_log) {
+    // 日志中的记录包含记录头，重做时恢复插入事务的 xmin 和 cid
+    Record logged(record.GetValues());
+    logged.SetXmin(xid);
+    logged.SetCid(cid);
+    auto size = logged.GetSize();
+    auto buf = std::make_unique<char[]>(size);
+    logged.SerializeTo(buf.get());
+    pax_page->SetPageLSN(log_manager_.AppendPaxInsertLog(xid, oid_, page_id, slot_id, size, buf.get()));
+  }
+  fsm_.Update(page_id, pax_page->GetFreeSpaceSize());
+  return {page_id, slot_id};
+}
+
+void Table::DeleteColumnarRecord(const Rid &rid, xid_t xid, bool write_log) {
+  PaxPage pax_page(buffer_pool_.FetchPageWrite(db_oid_, oid_, rid.page_id_), column_list_);
+  pax_page.DeleteRecord(rid.slot_id_, xid);
+  if (write_log) {
+    pax_page.SetPageLSN(log_manager_.AppendPaxDeleteLog(xid, oid_, rid.page_id_, rid.slot_id_));
+  }
+}
+
+void Table::StoreExternalValues(Record &record, bool write_log) {
+  const auto &values = record.GetValues();
+  for (size_t i = 0; i < values.size(); i++) {
+    if (values[i].IsExternal() && values[i].GetExternalReader() != overflow_) {
+      record.SetValue(i, Value(values[i].GetValue<std::string>(), values[i].GetType()));
+    }
+  }
+  size_t max_size = buffer_pool_.GetPageSize() - PAGE_RESERVED_SIZE;
+  while (record.GetSize() > max_size) {
+    std::optional<size_t> longest;
+    for (size_t i = 0; i < values.size(); i++) {
+      if (values[i].GetType() != Type::VARCHAR || values[i].IsNull() || values[i].IsExternal() ||
+          values[i].GetSize() <= EXTERNAL_POINTER_SIZE) {
+        continue;
+      }
+      if (!longest.has_value() || values[i].GetSize() > values[*longest].GetSize()) {
+        longest = i;
+      }
+    }
+    if (!longest.has_value()) {
+      throw DbException("Record size too large: " + std::to_string(record.GetSize()));
+    }
+    auto str = values[*longest].GetValue<std::string>();
+    auto pointer = overflow_->Write(str, write_log);
+    record.SetValue(*longest, Value::External(Type::VARCHAR, std::move(pointer), overflow_, &str));
+  }
+}
+
 oid_t Table::GetOid() const { return oid_; }
 
 oid_t Table::GetDbOid() const { return db_oid_; }
@@ -1,29 +1,71 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "catalog/column_list.h"
 #include "common/types.h"
 #include "log/log_manager.h"
 #include "storage/buffer_pool.h"
+#include "table/free_space_map.h"
+#include "table/overflow_storage.h"
 #include "table/record.h"
+#include "table/visibility_map.h"
+#include "table/zone_map.h"
 
 namespace huadb {
 
+// VACUUM 的执行结果
+struct VacuumResult {
+  size_t removed_count_ = 0;      // 回收的记录数目
+  size_t truncated_count_ = 0;    // 截断的页面数目
+  size_t all_visible_count_ = 0;  // 标记为全可见的页面数目
+};
+
 class Table {
  public:
   Table(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, ColumnList column_list,
-        bool new_table, bool is_empty);
+        bool new_table, bool is_empty, StorageType storage_type = StorageType::ROW);
+  // 将空闲空间映射、可见性映射和区域映射写入磁盘
+  ~Table();
 
   // 插入记录，返回插入记录的 rid
   // write_log: 是否写日志。系统表操作不写日志，用户表操作写日志，lab 2 相关参数
-  Rid InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bool write_log);
+  // ring: 批量插入使用的页帧环，可为空指针
+  Rid InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bool write_log, BufferRing *ring = nullptr);
   // 删除记录
   void DeleteRecord(const Rid &rid, xid_t xid, bool write_log);
-  // 更新记录
-  Rid UpdateRecord(const Rid &rid, xid_t xid, cid_t cid, std::shared_ptr<Record> record, bool write_log);
+  // 更新记录，返回新版本的 rid
+  // 新版本能放入旧版本所在页面时进行页内更新，只写一条 UpdateLog；否则删除旧版本并插入新版本
+  // 页面空间不足时先回收页面中删除事务的 xid 小于 oldest_xmin 的旧版本，使反复更新的记录留在原页面
+  Rid UpdateRecord(const Rid &rid, xid_t xid, cid_t cid, std::shared_ptr<Record> record, bool write_log,
+                   xid_t oldest_xmin);
 
   // 用于系统表的原地更新，无需关注
   void UpdateRecordInPlace(const Record &record);
 
+  // 回收删除事务的 xid 小于 oldest_xmin 的记录，整理页面空间并更新空闲空间映射，然后截断表末尾的空页面
+  // 回收与截断均写日志，表至少保留一个页面；回收后所有记录对所有事务可见的页面在可见性映射中标记为全可见
+  VacuumResult Vacuum(xid_t oldest_xmin);
+  // 页面是否全可见，全可见页面中的记录对所有事务可见，扫描时无需检查记录的 xmin 和 xmax
+  bool IsAllVisible(pageid_t page_id) const;
+  // 根据区域映射判断页面中是否可能存在满足所有取值范围的记录，不可能时计入跳过的页面数目
+  bool PageMayMatch(pageid_t page_id, const std::vector<ScanRange> &ranges);
+
+  // 表的存储格式
+  StorageType GetStorageType() const;
+  // 表的页面数目，列存表的页面号连续且没有页面链表，扫描时据此判断是否结束
+  size_t GetPageCount();
+
+  // 页内更新的次数
+  size_t GetHotUpdateCount() const;
+  // 扫描根据区域映射跳过的页面数目
+  size_t GetZoneMapSkipCount() const;
+  // 压缩的列存表页面数目
+  size_t GetCompressedPageCount() const;
+  // 表的溢出存储，用于统计溢出值的读写次数
+  const OverflowStorage &GetOverflowStorage() const;
+
   // 获取表的第一个页面的页面号
   pageid_t GetFirstPageId() const;
 
@@ -32,12 +74,37 @@ class Table {
   const ColumnList &GetColumnList() const;
 
  private:
+  // 首次使用空闲空间映射前载入映射，映射文件不存在时遍历表的页面重建映射
+  // 映射文件中的页面可能少于表的实际页面（如崩溃恢复重做了新建页面），从已知的最后一个页面沿链表补全
+  void LoadFreeSpaceMap();
+  // 首次使用区域映射前载入映射，映射文件不存在时遍历表的页面重建映射。系统表不使用区域映射
+  void LoadZoneMap();
+  // 行存表的插入，记录已经过 StoreExternalValues 处理
+  Rid InsertRowRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bool write_log, BufferRing *ring);
+  // 列存表的插入与删除，新版本总是追加到有空闲槽位的页面中，删除只设置 xmax
+  // 压缩表需要新页面时先压缩最后一个页面，页面压缩后只插入能用页面的编码表示的记录
+  Rid InsertColumnarRecord(const Record &record, xid_t xid, cid_t cid, bool write_log, BufferRing *ring);
+  void DeleteColumnarRecord(const Rid &rid, xid_t xid, bool write_log);
+  // 记录超过页面可容纳的最大长度时，依次将其中最长的 VARCHAR 值移入溢出存储，直到记录能放入一个页面
+  // 来自其他表的行外存储值先读出，再按本表的规则重新存储
+  void StoreExternalValues(Record &record, bool write_log);
+
   BufferPool &buffer_pool_;
   LogManager &log_manager_;
   oid_t oid_;
   oid_t db_oid_;
   pageid_t first_page_id_;  // 第一个页面的页面号
   ColumnList column_list_;  // 表的 schema 信息
+  StorageType storage_type_;
+  FreeSpaceMap fsm_;        // 空闲空间映射，页面号即映射中的下标
+  std::once_flag fsm_loaded_;
+  VisibilityMap vm_;  // 可见性映射，修改页面前需清除页面的全可见标记
+  ZoneMap zone_map_;  // 区域映射，插入记录后扩展所在页面的上下界
+  std::once_flag zone_map_loaded_;
+  std::shared_ptr<OverflowStorage> overflow_;  // 溢出存储，同时作为本表行外存储值的读取器
+  std::atomic<size_t> hot_update_count_ = 0;
+  std::atomic<size_t> zone_map_skip_count_ = 0;
+  std::atomic<size_t> compressed_page_count_ = 0;
 };
 
 }  // namespace huadb
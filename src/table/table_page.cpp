@@ -1,10 +1,14 @@
 #include "table/table_page.h"
 
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 namespace huadb {
 
-TablePage::TablePage(std::shared_ptr<Page> page) : page_(page) {
+TablePage::TablePage(PageGuard page_guard) : TablePage(page_guard.GetPage()) { page_guard_ = std::move(page_guard); }
+
+TablePage::TablePage(Page *page) : page_(page) {
   page_data_ = page->GetData();
   db_size_t offset = 0;
   page_lsn_ = reinterpret_cast<lsn_t *>(page_data_);
@@ -23,31 +27,32 @@ void TablePage::Init() {
   *page_lsn_ = 0;
   *next_page_id_ = NULL_PAGE_ID;
   *lower_ = PAGE_HEADER_SIZE;
-  *upper_ = DB_PAGE_SIZE;
+  *upper_ = page_->GetSize();
   page_->SetDirty();
 }
 
 slotid_t TablePage::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid) {
-  // 在记录头添加事务信息（xid 和 cid）
-  // LAB 3 BEGIN
-
-  // 维护 lower 和 upper 指针
-  // 设置 slots 数组
-  // 将 record 写入 page data
-  // 将 page 标记为 dirty
-  // 返回插入的 slot id
-  // LAB 1 BEGIN
-  return 0;
+  record->SetXmin(xid);
+  record->SetCid(cid);
+  record->SetXmax(NULL_XID);
+  record->SetDeleted(false);
+  auto size = record->GetSize();
+  *upper_ -= size;
+  slotid_t slot_id = GetRecordCount();
+  slots_[slot_id].offset_ = *upper_;
+  slots_[slot_id].size_ = size;
+  *lower_ += sizeof(Slot);
+  record->SerializeTo(page_data_ + *upper_);
+  page_->SetDirty();
+  return slot_id;
 }
 
 void TablePage::DeleteRecord(slotid_t slot_id, xid_t xid) {
-  // 更改实验 1 的实现，改为通过 xid 标记删除
-  // LAB 3 BEGIN
-
-  // 将 slot_id 对应的 record 标记为删除
-  // 可使用 Record::DeserializeHeaderFrom 函数读取记录头
-  // 将 page 标记为 dirty
-  // LAB 1 BEGIN
+  Record r;
+  r.DeserializeHeaderFrom(page_data_ + slots_[slot_id].offset_);
+  r.SetXmax(xid);
+  r.SerializeHeaderTo(page_data_ + slots_[slot_id].offset_);
+  page_->SetDirty();
 }
 
 void TablePage::UpdateRecordInPlace(const Record &record, slotid_t slot_id) {
@@ -56,26 +61,107 @@ void TablePage::UpdateRecordInPlace(const Record &record, slotid_t slot_id) {
 }
 
 std::shared_ptr<Record> TablePage::GetRecord(Rid rid, const ColumnList &column_list) {
-  // 根据 slot_id 获取 record
-  // 新建 record 并设置 rid
-  // LAB 1 BEGIN
-  return nullptr;
+  auto record = std::make_shared<Record>();
+  record->DeserializeFrom(page_data_ + slots_[rid.slot_id_].offset_, column_list);
+  record->SetRid(rid);
+  return record;
 }
 
-void TablePage::UndoDeleteRecord(slotid_t slot_id) {
-  // 修改 undo delete 的逻辑
-  // LAB 3 BEGIN
+const char *TablePage::GetRecordData(slotid_t slot_id) const { return page_data_ + slots_[slot_id].offset_; }
 
-  // 清除记录的删除标记
-  // 将页面设为 dirty
-  // LAB 2 BEGIN
+void TablePage::UndoDeleteRecord(slotid_t slot_id) {
+  Record r;
+  r.DeserializeHeaderFrom(page_data_ + slots_[slot_id].offset_);
+  r.SetXmax(NULL_XID);
+  r.SerializeHeaderTo(page_data_ + slots_[slot_id].offset_);
+  page_->SetDirty();
 }
 
 void TablePage::RedoInsertRecord(slotid_t slot_id, char *raw_record, db_size_t page_offset, db_size_t record_size) {
-  // 将 raw_record 写入 page data
-  // 注意维护 lower 和 upper 指针，以及 slots 数组
-  // 将页面设为 dirty
-  // LAB 2 BEGIN
+  memcpy(page_data_ + page_offset, raw_record, record_size);
+  slots_[slot_id].offset_ = page_offset;
+  slots_[slot_id].size_ = record_size;
+  if (*lower_ < PAGE_HEADER_SIZE + (slot_id + 1) * sizeof(Slot)) {
+    *lower_ = PAGE_HEADER_SIZE + (slot_id + 1) * sizeof(Slot);
+  }
+  if (*upper_ > page_offset) {
+    *upper_ = page_offset;
+  }
+  page_->SetDirty();
+}
+
+db_size_t TablePage::Vacuum(xid_t oldest_xmin) {
+  db_size_t removed = 0;
+  slotid_t record_count = GetRecordCount();
+  for (slotid_t slot_id = 0; slot_id < record_count; slot_id++) {
+    if (IsSlotUnused(slot_id)) {
+      continue;
+    }
+    Record record;
+    record.DeserializeHeaderFrom(page_data_ + slots_[slot_id].offset_);
+    if (record.GetXmax() != NULL_XID && record.GetXmax() < oldest_xmin) {
+      slots_[slot_id] = {0, 0};
+      removed++;
+    }
+  }
+  if (removed == 0) {
+    return 0;
+  }
+  while (record_count > 0 && IsSlotUnused(record_count - 1)) {
+    record_count--;
+  }
+  *lower_ = PAGE_HEADER_SIZE + record_count * sizeof(Slot);
+  // 按槽号顺序从页面末尾开始重新排列记录，与插入时的布局一致
+  std::vector<char> old_data(page_data_, page_data_ + page_->GetSize());
+  *upper_ = page_->GetSize();
+  for (slotid_t slot_id = 0; slot_id < record_count; slot_id++) {
+    if (IsSlotUnused(slot_id)) {
+      continue;
+    }
+    *upper_ -= slots_[slot_id].size_;
+    memcpy(page_data_ + *upper_, old_data.data() + slots_[slot_id].offset_, slots_[slot_id].size_);
+    slots_[slot_id].offset_ = *upper_;
+  }
+  page_->SetDirty();
+  return removed;
+}
+
+slotid_t TablePage::MoveToUnusedSlot(slotid_t slot_id) {
+  assert(slot_id + 1 == GetRecordCount());
+  for (slotid_t unused_slot_id = 0; unused_slot_id < slot_id; unused_slot_id++) {
+    if (IsSlotUnused(unused_slot_id)) {
+      slots_[unused_slot_id] = slots_[slot_id];
+      *lower_ -= sizeof(Slot);
+      page_->SetDirty();
+      return unused_slot_id;
+    }
+  }
+  return slot_id;
+}
+
+bool TablePage::IsSlotUnused(slotid_t slot_id) const { return slots_[slot_id].size_ == 0; }
+
+bool TablePage::IsEmpty() const {
+  for (slotid_t slot_id = 0; slot_id < GetRecordCount(); slot_id++) {
+    if (!IsSlotUnused(slot_id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TablePage::IsAllVisible(xid_t oldest_xmin) const {
+  for (slotid_t slot_id = 0; slot_id < GetRecordCount(); slot_id++) {
+    if (IsSlotUnused(slot_id)) {
+      continue;
+    }
+    Record record;
+    record.DeserializeHeaderFrom(page_data_ + slots_[slot_id].offset_);
+    if (record.GetXmin() >= oldest_xmin || record.GetXmax() != NULL_XID) {
+      return false;
+    }
+  }
+  return true;
 }
 
 db_size_t TablePage::GetRecordCount() const { return (*lower_ - PAGE_HEADER_SIZE) / sizeof(Slot); }
@@ -119,9 +205,11 @@ std::string TablePage::ToString() const {
   oss << "  slots: " << std::endl;
   for (size_t i = 0; i < GetRecordCount(); i++) {
     oss << "    " << i << ": offset " << slots_[i].offset_ << ", size " << slots_[i].size_ << " ";
-    if (slots_[i].size_ <= RECORD_HEADER_SIZE) {
+    if (IsSlotUnused(i)) {
+      oss << "unused" << std::endl;
+    } else if (slots_[i].size_ <= RECORD_HEADER_SIZE) {
       oss << "***Error: record size smaller than header size***" << std::endl;
-    } else if (slots_[i].offset_ + RECORD_HEADER_SIZE >= DB_PAGE_SIZE) {
+    } else if (slots_[i].offset_ + RECORD_HEADER_SIZE >= page_->GetSize()) {
       oss << "***Error: record offset out of page boundary***" << std::endl;
     } else {
       RecordHeader header;
@@ -5,6 +5,7 @@
 #include "common/types.h"
 #include "log/log_manager.h"
 #include "storage/page.h"
+#include "storage/page_guard.h"
 #include "table/record.h"
 
 namespace huadb {
@@ -16,7 +17,10 @@ class ColumnList;
 
 class TablePage {
  public:
-  explicit TablePage(std::shared_ptr<Page> page);
+  // 通过页面守卫构造，TablePage 存在期间页面保持 pin 住
+  explicit TablePage(PageGuard page_guard);
+  // 直接使用页面构造，需由调用者保证页面在 TablePage 存在期间有效
+  explicit TablePage(Page *page);
 
   // 页面初始化
   void Init();
@@ -31,12 +35,28 @@ class TablePage {
 
   // 获取记录
   std::shared_ptr<Record> GetRecord(Rid rid, const ColumnList &column_list);
+  // 获取记录序列化数据的起始位置，用于构造记录视图，只在页面被 pin 住期间有效
+  const char *GetRecordData(slotid_t slot_id) const;
 
   // Lab 2: 回滚删除操作
   void UndoDeleteRecord(slotid_t slot_id);
   // Lab 2: 重做插入操作
   void RedoInsertRecord(slotid_t slot_id, char *raw_record, db_size_t page_offset, db_size_t record_size);
 
+  // 回收删除事务的 xid 小于 oldest_xmin 的记录，这些记录对所有事务都不可见，返回回收的记录数目
+  // 回收的槽位大小记为 0，其余记录的槽号不变，记录数据重新紧凑排列在页面末尾；末尾的空闲槽位被移除
+  // 结果只取决于页面内容和 oldest_xmin，重做时再次执行得到相同的页面
+  db_size_t Vacuum(xid_t oldest_xmin);
+  // 将刚插入最后一个槽位 slot_id 的记录移动到第一个已被回收的槽位，并移除最后一个槽位，返回记录所在的槽号
+  // 页内更新时复用回收的槽位，避免反复更新的页面中槽位数组不断增长；没有回收的槽位时不做修改
+  slotid_t MoveToUnusedSlot(slotid_t slot_id);
+  // 槽位是否已被 VACUUM 回收，扫描时需跳过
+  bool IsSlotUnused(slotid_t slot_id) const;
+  // 页面中是否没有记录
+  bool IsEmpty() const;
+  // 页面中的记录是否对所有事务可见，即所有记录均未被删除，且插入事务的 xid 小于 oldest_xmin
+  bool IsAllVisible(xid_t oldest_xmin) const;
+
   // 获取记录数目
   db_size_t GetRecordCount() const;
   // Lab 2: 获取 page lsn
@@ -59,7 +79,8 @@ class TablePage {
   std::string ToString() const;
 
  private:
-  std::shared_ptr<Page> page_;
+  PageGuard page_guard_;
+  Page *page_;
   char *page_data_;
   lsn_t *page_lsn_;         // LAB 2: PageLSN
   pageid_t *next_page_id_;  // 下一个页面的页面号
@@ -1,23 +1,178 @@
 #include "table/table_scan.h"
 
+#include <numeric>
+
+#include "common/exceptions.h"
+#include "table/pax_page.h"
 #include "table/table_page.h"
 
 namespace huadb {
 
-TableScan::TableScan(BufferPool &buffer_pool, std::shared_ptr<Table> table, Rid rid)
-    : buffer_pool_(buffer_pool), table_(std::move(table)), rid_(rid) {}
+TableScan::TableScan(BufferPool &buffer_pool, std::shared_ptr<Table> table, Rid rid, bool read_only,
+                     std::optional<std::vector<size_t>> column_ids, std::vector<ScanRange> ranges)
+    : buffer_pool_(buffer_pool), table_(std::move(table)), rid_(rid), ranges_(std::move(ranges)) {
+  if (column_ids.has_value()) {
+    column_ids_ = std::move(*column_ids);
+  } else {
+    column_ids_.resize(table_->GetColumnList().Length());
+    std::iota(column_ids_.begin(), column_ids_.end(), 0);
+  }
+  // 缓存中没有脏页时磁盘上的表文件即为最新内容，可以绕过 buffer pool 读取
+  if (read_only && table_->GetDbOid() != SYSTEM_DATABASE_OID &&
+      !buffer_pool_.HasDirtyPages(table_->GetDbOid(), table_->GetOid())) {
+    try {
+      mapped_ = std::make_unique<MappedFile>(table_->GetDbOid(), table_->GetOid(), buffer_pool_.GetPageSize());
+    } catch (DbException &) {
+      // 表文件为空或映射失败，通过 buffer pool 扫描
+    }
+  }
+  if (mapped_ == nullptr) {
+    ring_ = buffer_pool_.CreateBulkReadRing(table_->GetDbOid(), table_->GetOid());
+  }
+}
 
 std::shared_ptr<Record> TableScan::GetNextRecord(xid_t xid, IsolationLevel isolation_level, cid_t cid,
                                                  const std::unordered_set<xid_t> &active_xids) {
+  if (table_->GetStorageType() != StorageType::ROW) {
+    return GetNextColumnarRecord(xid, isolation_level, cid, active_xids);
+  }
+
+  while (rid_.page_id_ != NULL_PAGE_ID) {
+    if (rid_.slot_id_ == 0) {
+      rid_.page_id_ = SkipPages(rid_.page_id_);
+      if (rid_.page_id_ == NULL_PAGE_ID) {
+        break;
+      }
+      ReadAhead(rid_.page_id_);
+    }
+    // 在同一页面中连续判断记录，找到满足条件的可见记录或页面中的记录均已判断时才释放页面
+    TablePage table_page(FetchPage(rid_.page_id_));
+    all_visible_ = table_->IsAllVisible(rid_.page_id_);
+    const auto &column_list = table_->GetColumnList();
+    while (rid_.slot_id_ < table_page.GetRecordCount()) {
+      Rid rid = {rid_.page_id_, rid_.slot_id_++};
+      if (table_page.IsSlotUnused(rid.slot_id_)) {
+        continue;
+      }
+      view_.Reset(table_page.GetRecordData(rid.slot_id_), column_list, rid);
+      if (!all_visible_ && !IsVisible(view_.GetHeader(), xid, isolation_level, cid, active_xids)) {
+        continue;
+      }
+      if (predicate_ != nullptr && !predicate_(view_)) {
+        continue;
+      }
+      return projector_ != nullptr ? projector_(view_) : table_page.GetRecord(rid, column_list);
+    }
+    rid_ = {table_page.GetNextPageId(), 0};
+  }
+  return nullptr;
+}
+
+void TableScan::SetViewCallbacks(ViewPredicate predicate, ViewProjector projector) {
+  if (table_->GetStorageType() != StorageType::ROW) {
+    throw DbException("Record views are only supported on row tables");
+  }
+  predicate_ = std::move(predicate);
+  projector_ = std::move(projector);
+}
+
+bool TableScan::IsVisible(const Record &record, xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                          const std::unordered_set<xid_t> &active_xids) const {
   // 根据事务隔离级别及活跃事务集合，判断记录是否可见
   // LAB 3 BEGIN
 
-  // 每次调用读取一条记录
-  // 读取时更新 rid_ 变量，避免重复读取
-  // 扫描结束时，返回空指针
-  // 注意处理扫描空表的情况（rid_.page_id_ 为 NULL_PAGE_ID）
-  // LAB 1 BEGIN
+  auto xmin = record.GetXmin();
+  auto xmax = record.GetXmax();
+  bool rc = isolation_level == IsolationLevel::READ_COMMITTED || xid == NULL_XID;
+  bool ins_visible;
+  if (xmin == xid) {
+    ins_visible = cid == NULL_CID || record.GetCid() < cid;
+  } else {
+    ins_visible = xmin == DDL_XID || xmin == NULL_XID || (active_xids.count(xmin) == 0 && (rc || xmin < xid));
+  }
+  if (!ins_visible) {
+    return false;
+  }
+  bool deleted =
+      xmax != NULL_XID && (xmax == xid || xmax == DDL_XID || (active_xids.count(xmax) == 0 && (rc || xmax < xid)));
+  return !deleted;
+}
+
+std::shared_ptr<Record> TableScan::GetNextColumnarRecord(xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                                                         const std::unordered_set<xid_t> &active_xids) {
+  // 列存表的页面号连续，扫描到表的最后一个页面为止
+  size_t page_count = rid_.page_id_ == NULL_PAGE_ID ? 0 : table_->GetPageCount();
+  while (rid_.page_id_ < page_count) {
+    if (rid_.slot_id_ == 0) {
+      rid_.page_id_ = SkipPages(rid_.page_id_);
+      if (rid_.page_id_ == NULL_PAGE_ID) {
+        break;
+      }
+      ReadAhead(rid_.page_id_);
+    }
+    // 在同一页面中连续判断记录，找到可见的记录或页面中的记录均已判断时才释放页面
+    PaxPage pax_page(FetchPage(rid_.page_id_), table_->GetColumnList());
+    // 先在记录的编码上判断取值范围，不满足的记录无需判断可见性和解码。页面可能在两次调用之间被压缩，此时重新准备
+    if (!ranges_.empty() && (filter_page_id_ != rid_.page_id_ || filter_.encoded_ != pax_page.IsEncoded())) {
+      filter_ = pax_page.PrepareFilter(ranges_);
+      filter_page_id_ = rid_.page_id_;
+    }
+    while (rid_.slot_id_ < pax_page.GetRecordCount()) {
+      auto slot_id = rid_.slot_id_++;
+      if (!ranges_.empty() && !pax_page.Matches(slot_id, ranges_, filter_)) {
+        continue;
+      }
+      if (IsVisible(pax_page.GetRecordHeader(slot_id), xid, isolation_level, cid, active_xids)) {
+        return pax_page.GetRecord({rid_.page_id_, slot_id}, column_ids_);
+      }
+    }
+    rid_ = {rid_.page_id_ + 1, 0};
+  }
   return nullptr;
 }
 
+pageid_t TableScan::SkipPages(pageid_t page_id) {
+  if (ranges_.empty() || page_id == NULL_PAGE_ID) {
+    return page_id;
+  }
+  size_t page_count = table_->GetPageCount();
+  pageid_t first_page_id = page_id;
+  while (page_id < page_count && !table_->PageMayMatch(page_id, ranges_)) {
+    page_id++;
+  }
+  if (page_id != first_page_id && page_id >= page_count) {
+    return NULL_PAGE_ID;
+  }
+  return page_id;
+}
+
+ReadPageGuard TableScan::FetchPage(pageid_t page_id) {
+  if (mapped_ != nullptr && page_id < mapped_->GetPageCount()) {
+    return mapped_->FetchPage(page_id);
+  }
+  if (ring_ != nullptr) {
+    ring_->SetScanPosition(page_id);
+  }
+  return buffer_pool_.FetchPageRead(table_->GetDbOid(), table_->GetOid(), page_id, ring_.get());
+}
+
+void TableScan::ReadAhead(pageid_t page_id) {
+  size_t window = buffer_pool_.GetReadAheadPages();
+  // 映射的页面由内核按 MADV_SEQUENTIAL 提示预读
+  if (window == 0 || page_id == NULL_PAGE_ID || mapped_ != nullptr) {
+    return;
+  }
+  // 只预读尚未发起预读的页面
+  pageid_t first_page_id = page_id + 1;
+  if (read_ahead_until_ != NULL_PAGE_ID && read_ahead_until_ >= first_page_id) {
+    first_page_id = read_ahead_until_ + 1;
+  }
+  pageid_t last_page_id = page_id + window;
+  if (first_page_id > last_page_id) {
+    return;
+  }
+  buffer_pool_.ReadAhead(table_->GetDbOid(), table_->GetOid(), first_page_id, last_page_id - first_page_id + 1, ring_);
+  read_ahead_until_ = last_page_id;
+}
+
 }  // namespace huadb
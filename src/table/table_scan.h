@@ -1,17 +1,34 @@
 #pragma once
 
+#include <functional>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "common/types.h"
 #include "storage/buffer_pool.h"
+#include "storage/mapped_file.h"
+#include "table/pax_page.h"
 #include "table/record.h"
+#include "table/record_view.h"
 #include "table/table.h"
 
 namespace huadb {
 
 class TableScan {
  public:
-  TableScan(BufferPool &buffer_pool, std::shared_ptr<Table> table, Rid rid);
+  // 在记录视图上判断记录是否满足过滤条件
+  using ViewPredicate = std::function<bool(const RecordView &)>;
+  // 由记录视图构造扫描返回的记录，如只计算投影的列
+  using ViewProjector = std::function<std::shared_ptr<Record>(const RecordView &)>;
+
+  // 表的页面数目超过缓存的 1/BULK_ACCESS_FRACTION 时，扫描通过页帧环读取页面，避免冲掉缓存中的其他页面
+  // read_only 为 true 且表在缓存中没有脏页时，扫描直接从映射到内存的表文件读取页面，不经过 buffer pool
+  // column_ids 只对列存表有效，给出时只解码这些列，其余列的值为空，用于只读查询跳过用不到的列
+  // ranges 为上层 Filter 对列取值范围的限定，扫描跳过区域映射表明不可能包含满足条件的记录的页面
+  // 列存表扫描还据此在页面中跳过不满足条件的记录
+  TableScan(BufferPool &buffer_pool, std::shared_ptr<Table> table, Rid rid, bool read_only = false,
+            std::optional<std::vector<size_t>> column_ids = std::nullopt, std::vector<ScanRange> ranges = {});
   // xid: 事务 id
   // isolation_level: 隔离级别
   // cid: 事物内部 command id
@@ -19,11 +36,41 @@ class TableScan {
   // 均为 Lab 3 相关参数
   std::shared_ptr<Record> GetNextRecord(xid_t xid = NULL_XID, IsolationLevel isolation_level = DEFAULT_ISOLATION_LEVEL,
                                         cid_t cid = NULL_CID, const std::unordered_set<xid_t> &active_xids = {});
+  // 设置在页面中的记录视图上执行的过滤条件和投影，只对行存表有效
+  // 扫描在记录所在页面被 pin 住时判断过滤条件，不满足的记录不构造 Record，也不离开页面
+  // projector 非空时由其构造返回的记录，否则返回完整的记录。两者不能修改表，否则可能与扫描持有的页面锁冲突
+  void SetViewCallbacks(ViewPredicate predicate, ViewProjector projector);
 
  private:
+  // 根据事务隔离级别及活跃事务集合，判断记录是否可见，只使用记录头中的 xmin、xmax 和 cid
+  bool IsVisible(const Record &record, xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                 const std::unordered_set<xid_t> &active_xids) const;
+  // 扫描列存表，先在记录的编码上判断取值范围，再读取记录头判断可见性，可见时才解码所需的列
+  std::shared_ptr<Record> GetNextColumnarRecord(xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                                                const std::unordered_set<xid_t> &active_xids);
+  // 从 page_id 开始跳过不可能包含满足 ranges_ 的记录的页面，返回第一个不能跳过的页面
+  // 之后的页面均可跳过时返回 NULL_PAGE_ID。表的页面号连续，跳过页面时无需读取页面
+  pageid_t SkipPages(pageid_t page_id);
+  // 获取页面用于读取，映射范围内的页面从映射中读取，大表扫描时通过页帧环读取
+  ReadPageGuard FetchPage(pageid_t page_id);
+  // 扫描进入新页面时调用，异步预读该页面之后的页面，预读窗口由 buffer pool 的 read_ahead_pages 决定
+  // 表的页面按页面号顺序分配，因此预读页面号连续的后续页面
+  void ReadAhead(pageid_t page_id);
+
   BufferPool &buffer_pool_;
   std::shared_ptr<Table> table_;
-  Rid rid_;  // 当前扫描到的记录的 rid
+  Rid rid_;                                   // 当前扫描到的记录的 rid
+  pageid_t read_ahead_until_ = NULL_PAGE_ID;  // 已发起预读的最大页面号
+  bool all_visible_ = false;                  // 当前页面是否全可见，每次获取页面后更新
+  std::shared_ptr<BufferRing> ring_;          // 大表扫描使用的页帧环，小表为空指针
+  std::unique_ptr<MappedFile> mapped_;        // 只读扫描映射的表文件，不使用映射时为空指针
+  std::vector<size_t> column_ids_;            // 列存表扫描需要解码的列
+  std::vector<ScanRange> ranges_;             // 用于跳过页面和记录的列取值范围，为空时不跳过
+  PaxFilter filter_;                          // 列存表当前页面的取值范围判断
+  pageid_t filter_page_id_ = NULL_PAGE_ID;    // filter_ 所属的页面
+  RecordView view_;                           // 行存表扫描在页面中逐条复用的记录视图
+  ViewPredicate predicate_;                   // 记录视图上的过滤条件，为空时不过滤
+  ViewProjector projector_;                   // 由记录视图构造返回的记录，为空时返回完整的记录
 };
 
 }  // namespace huadb
@@ -0,0 +1,76 @@
+#include "table/visibility_map.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "common/constants.h"
+#include "storage/disk.h"
+
+namespace huadb {
+
+VisibilityMap::VisibilityMap(oid_t db_oid, oid_t table_oid) : db_oid_(db_oid), table_oid_(table_oid) {}
+
+bool VisibilityMap::IsAllVisible(pageid_t page_id) const {
+  std::scoped_lock lock(mutex_);
+  size_t index = page_id / 8;
+  return index < bits_.size() && (bits_[index] >> (page_id % 8) & 1) != 0;
+}
+
+void VisibilityMap::SetAllVisible(pageid_t page_id) {
+  std::scoped_lock lock(mutex_);
+  size_t index = page_id / 8;
+  if (index >= bits_.size()) {
+    bits_.resize(index + 1, 0);
+  }
+  bits_[index] |= 1 << (page_id % 8);
+}
+
+void VisibilityMap::Clear(pageid_t page_id) {
+  std::scoped_lock lock(mutex_);
+  size_t index = page_id / 8;
+  if (index < bits_.size()) {
+    bits_[index] &= ~(1 << (page_id % 8));
+  }
+}
+
+void VisibilityMap::Truncate(size_t page_count) {
+  std::scoped_lock lock(mutex_);
+  size_t size = (page_count + 7) / 8;
+  if (bits_.size() > size) {
+    bits_.resize(size);
+  }
+  // 清除最后一个字节中超出 page_count 的位
+  if (page_count % 8 != 0 && bits_.size() == size) {
+    bits_.back() &= (1 << (page_count % 8)) - 1;
+  }
+}
+
+bool VisibilityMap::Load() {
+  auto path = GetPath();
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::vector<char> bits{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  in.close();
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+
+  std::scoped_lock lock(mutex_);
+  bits_.assign(bits.begin(), bits.end());
+  return true;
+}
+
+void VisibilityMap::Save() const {
+  if (!Disk::FileExists(Disk::GetFilePath(db_oid_, table_oid_))) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  std::ofstream out(GetPath(), std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(bits_.data()), bits_.size());
+}
+
+std::string VisibilityMap::GetPath() const { return Disk::GetFilePath(db_oid_, table_oid_) + VM_SUFFIX; }
+
+}  // namespace huadb
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+
+namespace huadb {
+
+// 可见性映射，每个页面 1 位，标记页面中的所有记录是否对所有事务可见（全可见）
+// 全可见标记由 VACUUM 设置，页面被修改前清除；扫描全可见页面时无需逐条检查记录的 xmin 和 xmax
+// 映射不写日志，与空闲空间映射一样只在正常关闭时写入磁盘，读取后删除文件，异常退出后所有页面视为非全可见
+// 标记只会在页面被修改前清除，因此被标记的页面一定全可见，未被标记的页面则不一定不是全可见
+// 线程安全
+class VisibilityMap {
+ public:
+  VisibilityMap(oid_t db_oid, oid_t table_oid);
+
+  // 页面是否全可见，超出映射范围的页面不是全可见
+  bool IsAllVisible(pageid_t page_id) const;
+  // 将页面标记为全可见，页面号超出映射范围时扩展映射
+  void SetAllVisible(pageid_t page_id);
+  // 清除页面的全可见标记
+  void Clear(pageid_t page_id);
+  // 表被截断为 page_count 个页面后，清除之后的页面的标记
+  void Truncate(size_t page_count);
+
+  // 读取磁盘上的映射文件，读取后删除该文件，文件不存在时返回 false
+  bool Load();
+  // 将映射写入磁盘，表文件已不存在（表已被删除）时不写入
+  void Save() const;
+
+ private:
+  std::string GetPath() const;
+
+  oid_t db_oid_;
+  oid_t table_oid_;
+  mutable std::mutex mutex_;
+  // 页面 page_id 对应 bits_[page_id / 8] 的第 page_id % 8 位
+  std::vector<uint8_t> bits_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,293 @@
+#include "table/zone_map.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include "common/constants.h"
+#include "common/type_util.h"
+#include "storage/disk.h"
+
+namespace huadb {
+
+namespace {
+
+// 取值范围的上下界转换为与列相同的比较类型，类型不兼容时返回空，该范围不用于跳过页面
+std::optional<double> NumericBound(const Value &bound) {
+  if (bound.GetType() == Type::INT) {
+    return bound.GetValue<int32_t>();
+  }
+  if (bound.GetType() == Type::DOUBLE) {
+    return bound.GetValue<double>();
+  }
+  return std::nullopt;
+}
+
+std::optional<std::string> StringBound(const Value &bound) {
+  if (TypeUtil::IsString(bound.GetType())) {
+    return bound.GetValue<std::string>();
+  }
+  return std::nullopt;
+}
+
+// 上下界为 [min, max] 的值中是否可能有满足取值范围的值，lower 和 upper 为空表示无界
+template <typename T>
+bool Overlaps(const T &min, const T &max, const std::optional<T> &lower, bool lower_inclusive,
+              const std::optional<T> &upper, bool upper_inclusive) {
+  if (lower.has_value() && (max < *lower || (max == *lower && !lower_inclusive))) {
+    return false;
+  }
+  if (upper.has_value() && (min > *upper || (min == *upper && !upper_inclusive))) {
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+void WriteBinary(std::ofstream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadBinary(std::ifstream &in, T &value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+void WriteString(std::ofstream &out, const std::string &str) {
+  WriteBinary(out, static_cast<db_size_t>(str.size()));
+  out.write(str.data(), str.size());
+}
+
+bool ReadString(std::ifstream &in, std::string &str) {
+  db_size_t size;
+  if (!ReadBinary(in, size)) {
+    return false;
+  }
+  str.resize(size);
+  return static_cast<bool>(in.read(str.data(), size));
+}
+
+}  // namespace
+
+bool ScanRange::Contains(const Value &value) const {
+  if (value.IsNull()) {
+    return false;
+  }
+  if (TypeUtil::IsString(value.GetType())) {
+    auto lower = lower_.has_value() ? StringBound(*lower_) : std::nullopt;
+    auto upper = upper_.has_value() ? StringBound(*upper_) : std::nullopt;
+    if (lower_.has_value() != lower.has_value() || upper_.has_value() != upper.has_value()) {
+      return true;
+    }
+    auto str = value.GetValue<std::string>();
+    return Overlaps(str, str, lower, lower_inclusive_, upper, upper_inclusive_);
+  }
+  double number;
+  if (value.GetType() == Type::INT) {
+    number = value.GetValue<int32_t>();
+  } else if (value.GetType() == Type::UINT) {
+    number = value.GetValue<uint32_t>();
+  } else if (value.GetType() == Type::DOUBLE) {
+    number = value.GetValue<double>();
+  } else {
+    return true;
+  }
+  auto lower = lower_.has_value() ? NumericBound(*lower_) : std::nullopt;
+  auto upper = upper_.has_value() ? NumericBound(*upper_) : std::nullopt;
+  if (lower_.has_value() != lower.has_value() || upper_.has_value() != upper.has_value()) {
+    return true;
+  }
+  return Overlaps(number, number, lower, lower_inclusive_, upper, upper_inclusive_);
+}
+
+ZoneMap::ZoneMap(oid_t db_oid, oid_t table_oid, const ColumnList &column_list)
+    : db_oid_(db_oid), table_oid_(table_oid), zone_ids_(column_list.Length()) {
+  for (size_t i = 0; i < column_list.Length(); i++) {
+    const auto &column = column_list.GetColumn(i);
+    bool is_string = TypeUtil::IsString(column.GetType()) && column.GetMaxSize() <= ZONE_MAP_MAX_STRING_SIZE;
+    if (column.GetType() == Type::INT || column.GetType() == Type::DOUBLE || is_string) {
+      zone_ids_[i] = column_ids_.size();
+      column_ids_.push_back(i);
+      is_string_.push_back(is_string);
+    }
+  }
+}
+
+void ZoneMap::Reset(pageid_t page_id, const std::vector<std::shared_ptr<Record>> &records) {
+  // 在锁外计算上下界，避免并发的扫描读到计算了一半的摘要
+  PageZone page;
+  page.known_ = true;
+  page.columns_.resize(column_ids_.size());
+  for (const auto &record : records) {
+    Widen(page, *record);
+  }
+  std::scoped_lock lock(mutex_);
+  if (page_id >= pages_.size()) {
+    pages_.resize(page_id + 1);
+  }
+  pages_[page_id] = std::move(page);
+}
+
+void ZoneMap::Update(pageid_t page_id, const Record &record) {
+  if (column_ids_.empty()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (page_id >= pages_.size()) {
+    pages_.resize(page_id + 1);
+    pages_[page_id].known_ = true;
+    pages_[page_id].columns_.resize(column_ids_.size());
+  }
+  if (pages_[page_id].known_) {
+    Widen(pages_[page_id], record);
+  }
+}
+
+bool ZoneMap::MayMatch(pageid_t page_id, const std::vector<ScanRange> &ranges) const {
+  std::scoped_lock lock(mutex_);
+  if (page_id >= pages_.size() || !pages_[page_id].known_) {
+    return true;
+  }
+  const auto &page = pages_[page_id];
+  for (const auto &range : ranges) {
+    if (range.column_id_ >= zone_ids_.size() || !zone_ids_[range.column_id_].has_value()) {
+      continue;
+    }
+    auto zone_id = *zone_ids_[range.column_id_];
+    const auto &zone = page.columns_[zone_id];
+    // 空值与任何值比较的结果均不为真，该列没有非空值的页面不可能满足条件
+    if (!zone.has_value_) {
+      return false;
+    }
+    if (is_string_[zone_id]) {
+      auto lower = range.lower_.has_value() ? StringBound(*range.lower_) : std::nullopt;
+      auto upper = range.upper_.has_value() ? StringBound(*range.upper_) : std::nullopt;
+      if (range.lower_.has_value() != lower.has_value() || range.upper_.has_value() != upper.has_value()) {
+        continue;
+      }
+      if (!Overlaps(zone.min_str_, zone.max_str_, lower, range.lower_inclusive_, upper, range.upper_inclusive_)) {
+        return false;
+      }
+    } else {
+      auto lower = range.lower_.has_value() ? NumericBound(*range.lower_) : std::nullopt;
+      auto upper = range.upper_.has_value() ? NumericBound(*range.upper_) : std::nullopt;
+      if (range.lower_.has_value() != lower.has_value() || range.upper_.has_value() != upper.has_value()) {
+        continue;
+      }
+      if (!Overlaps(zone.min_, zone.max_, lower, range.lower_inclusive_, upper, range.upper_inclusive_)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void ZoneMap::Truncate(size_t page_count) {
+  std::scoped_lock lock(mutex_);
+  if (pages_.size() > page_count) {
+    pages_.resize(page_count);
+  }
+}
+
+bool ZoneMap::HasColumns() const { return !column_ids_.empty(); }
+
+bool ZoneMap::Load() {
+  auto path = GetPath();
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  // 文件格式：每个页面依次为已知标记，已知页面之后为各列的有值标记及最小值和最大值
+  std::vector<PageZone> pages;
+  bool valid = true;
+  for (uint8_t known; valid && ReadBinary(in, known);) {
+    auto &page = pages.emplace_back();
+    page.known_ = known != 0;
+    if (!page.known_) {
+      continue;
+    }
+    page.columns_.resize(column_ids_.size());
+    for (size_t i = 0; valid && i < column_ids_.size(); i++) {
+      auto &zone = page.columns_[i];
+      uint8_t has_value;
+      valid = ReadBinary(in, has_value);
+      zone.has_value_ = has_value != 0;
+      if (valid && zone.has_value_) {
+        valid = is_string_[i] ? ReadString(in, zone.min_str_) && ReadString(in, zone.max_str_)
+                              : ReadBinary(in, zone.min_) && ReadBinary(in, zone.max_);
+      }
+    }
+  }
+  in.close();
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  if (!valid) {
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  pages_ = std::move(pages);
+  return true;
+}
+
+void ZoneMap::Save() const {
+  if (!Disk::FileExists(Disk::GetFilePath(db_oid_, table_oid_))) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (pages_.empty()) {
+    return;
+  }
+  std::ofstream out(GetPath(), std::ios::binary | std::ios::trunc);
+  for (const auto &page : pages_) {
+    WriteBinary(out, static_cast<uint8_t>(page.known_));
+    if (!page.known_) {
+      continue;
+    }
+    for (size_t i = 0; i < column_ids_.size(); i++) {
+      const auto &zone = page.columns_[i];
+      WriteBinary(out, static_cast<uint8_t>(zone.has_value_));
+      if (!zone.has_value_) {
+        continue;
+      }
+      if (is_string_[i]) {
+        WriteString(out, zone.min_str_);
+        WriteString(out, zone.max_str_);
+      } else {
+        WriteBinary(out, zone.min_);
+        WriteBinary(out, zone.max_);
+      }
+    }
+  }
+}
+
+void ZoneMap::Widen(PageZone &page, const Record &record) const {
+  const auto &values = record.GetValues();
+  for (size_t i = 0; i < column_ids_.size(); i++) {
+    const auto &value = values[column_ids_[i]];
+    if (value.IsNull()) {
+      continue;
+    }
+    auto &zone = page.columns_[i];
+    if (is_string_[i]) {
+      auto str = value.GetValue<std::string>();
+      if (!zone.has_value_) {
+        zone.min_str_ = zone.max_str_ = str;
+      } else if (str < zone.min_str_) {
+        zone.min_str_ = str;
+      } else if (str > zone.max_str_) {
+        zone.max_str_ = str;
+      }
+    } else {
+      double number = value.GetType() == Type::INT ? value.GetValue<int32_t>() : value.GetValue<double>();
+      zone.min_ = zone.has_value_ ? std::min(zone.min_, number) : number;
+      zone.max_ = zone.has_value_ ? std::max(zone.max_, number) : number;
+    }
+    zone.has_value_ = true;
+  }
+}
+
+std::string ZoneMap::GetPath() const { return Disk::GetFilePath(db_oid_, table_oid_) + ZONE_MAP_SUFFIX; }
+
+}  // namespace huadb
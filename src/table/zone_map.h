@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "catalog/column_list.h"
+#include "common/types.h"
+#include "common/value.h"
+#include "table/record.h"
+
+namespace huadb {
+
+// 扫描条件限定的某一列的取值范围，上下界为空表示该方向无界
+// 由优化器从 Filter 中的列与常量的比较得到，扫描据此跳过区域映射表明不可能包含满足条件记录的页面
+struct ScanRange {
+  size_t column_id_;
+  std::optional<Value> lower_;
+  bool lower_inclusive_ = true;
+  std::optional<Value> upper_;
+  bool upper_inclusive_ = true;
+
+  // 值是否在取值范围内，空值不在任何范围内，值与上下界的类型不兼容时返回 true
+  bool Contains(const Value &value) const;
+};
+
+// 区域映射，记录每个页面中数值列和较短的字符串列的最小值与最大值（忽略空值）
+// 插入记录时扩展所在页面的上下界，删除记录时不收缩，VACUUM 回收页面空间后重新计算，因此上下界总是包含页面中的所有记录
+// 映射不写日志，只在表析构时写入磁盘，读取后删除文件；文件不存在时（如进程异常退出）由表遍历页面重建
+// 页面的摘要分为已知和未知两种，未知页面总是可能包含满足条件的记录
+// 线程安全
+class ZoneMap {
+ public:
+  ZoneMap(oid_t db_oid, oid_t table_oid, const ColumnList &column_list);
+
+  // 将页面的摘要置为已知，上下界为 records 中的值的上下界，用于重建映射和 VACUUM 后重新计算页面的上下界
+  void Reset(pageid_t page_id, const std::vector<std::shared_ptr<Record>> &records);
+  // 用记录的值扩展页面的上下界，未知页面保持未知
+  // 页面号超出映射范围说明页面是新分配的，之前没有记录，其摘要置为已知；跳过的页面号的摘要为未知
+  void Update(pageid_t page_id, const Record &record);
+  // 页面中是否可能存在满足所有取值范围的记录，超出映射范围的页面和未知页面总是可能
+  bool MayMatch(pageid_t page_id, const std::vector<ScanRange> &ranges) const;
+  // 表被截断为 page_count 个页面后，删除之后的页面的摘要
+  void Truncate(size_t page_count);
+  // 表中是否有区域映射记录上下界的列
+  bool HasColumns() const;
+
+  // 读取磁盘上的映射文件，读取后删除该文件，文件不存在或格式不符时返回 false
+  bool Load();
+  // 将映射写入磁盘，映射为空或表文件已不存在（表已被删除）时不写入
+  void Save() const;
+
+ private:
+  // 页面中某一列的上下界，数值列统一按 double 比较，字符串列按字典序比较
+  struct ColumnZone {
+    bool has_value_ = false;
+    double min_ = 0;
+    double max_ = 0;
+    std::string min_str_;
+    std::string max_str_;
+  };
+  struct PageZone {
+    bool known_ = false;
+    std::vector<ColumnZone> columns_;
+  };
+
+  // 用记录的值扩展页面的上下界，调用者需持有锁或独占 page
+  void Widen(PageZone &page, const Record &record) const;
+  std::string GetPath() const;
+
+  oid_t db_oid_;
+  oid_t table_oid_;
+  mutable std::mutex mutex_;
+  std::vector<size_t> column_ids_;               // 记录上下界的列在表中的下标
+  std::vector<bool> is_string_;                  // 与 column_ids_ 一一对应，列是否为字符串列
+  std::vector<std::optional<size_t>> zone_ids_;  // 表中每一列在 column_ids_ 中的下标，不记录上下界的列为空
+  std::vector<PageZone> pages_;                  // 页面号即下标
+};
+
+}  // namespace huadb
@@ -35,6 +35,9 @@ class TransactionManager {
   std::unordered_set<xid_t> GetSnapshot(xid_t xid) const;
   // 获取活跃事务表
   std::unordered_set<xid_t> GetActiveTransactions() const;
+  // 获取最老的仍可能被事务视为未提交的 xid，即活跃事务及其快照中的最小 xid，没有活跃事务时为 next_xid
+  // 小于该 xid 的事务已经结束，且所有活跃事务和之后开始的事务都将其视为已结束，用于 VACUUM 判断记录是否可回收
+  xid_t GetOldestXmin() const;
 
  private:
   // 释放事务持有的锁
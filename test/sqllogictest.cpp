@@ -16,6 +16,8 @@
 static constexpr const char *TEST_DIRECTORY = "huadb_test";
 
 std::unordered_map<std::string, std::unique_ptr<huadb::Connection>> connections;
+huadb::IOEngineType io_engine_type = huadb::IOEngineType::SYNC;
+size_t page_size = huadb::DEFAULT_PAGE_SIZE;
 
 bool CompareResult(const std::string &result, const std::string &expected_result, SortMode sort_mode,
                    std::ostringstream &error_stream) {
@@ -53,7 +55,7 @@ bool Run(const fs::path &path) {
   }
   parser.Parse();
   connections.clear();
-  auto database = std::make_unique<huadb::DatabaseEngine>();
+  auto database = std::make_unique<huadb::DatabaseEngine>(huadb::DEFAULT_BUFFER_SIZE, io_engine_type, false, page_size);
 
   for (const auto &record : parser.records) {
     switch (record->type_) {
@@ -71,7 +73,8 @@ bool Run(const fs::path &path) {
             database->Flush();
           } else if (statement.sql_.substr(0, 7) == "restart") {
             database.reset();
-            database = std::make_unique<huadb::DatabaseEngine>();
+            database =
+                std::make_unique<huadb::DatabaseEngine>(huadb::DEFAULT_BUFFER_SIZE, io_engine_type, false, page_size);
             connections.clear();
           } else {
             connections[statement.connection_name_]->SendQuery(statement.sql_, writer);
@@ -149,6 +152,15 @@ int main(int argc, char *argv[]) {
       .metavar("COUNT")
       .scan<'u', unsigned>();
   program.add_argument("-o", "--output").help("Report the result of the test").flag();
+  program.add_argument("--io-engine")
+      .help("I/O engine for batched page and log I/O (sync or io_uring)")
+      .default_value(std::string("sync"))
+      .metavar("ENGINE");
+  program.add_argument("--page-size")
+      .help("Page size of the test data directory")
+      .default_value(huadb::DEFAULT_PAGE_SIZE)
+      .metavar("SIZE")
+      .scan<'u', size_t>();
   program.add_argument("test_files").help("Test files to run").nargs(argparse::nargs_pattern::at_least_one);
 
   try {
@@ -161,6 +173,15 @@ int main(int argc, char *argv[]) {
 
   bool report_result = program.get<bool>("-o");
   int test_count = program.get<unsigned>("-c");
+  auto io_engine = program.get<std::string>("--io-engine");
+  if (io_engine != "sync" && io_engine != "io_uring") {
+    std::cerr << "Unknown I/O engine " << io_engine << std::endl;
+    std::exit(1);
+  }
+  if (io_engine == "io_uring") {
+    io_engine_type = huadb::IOEngineType::IO_URING;
+  }
+  page_size = program.get<size_t>("--page-size");
   auto test_files = program.get<std::vector<std::string>>("test_files");
 
   std::vector<fs::path> paths;